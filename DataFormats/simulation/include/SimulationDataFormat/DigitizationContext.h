@@ -128,9 +128,19 @@ class DigitizationContext
   // apply collision number cuts and potential relabeling of eventID
   void applyMaxCollisionFilter(long startOrbit, long orbitsPerTF, int maxColl);
 
-  // finalize timeframe structure (fixes the indices in mTimeFrameStartIndex)
+  // finalize timeframe structure (fixes the indices in mTimeFrameStartIndex and mTimeFrameStartIndexQED)
   void finalizeTimeframeStructure(long startOrbit, long orbitsPerTF);
 
+  // number of timeframes known to this context (after finalizeTimeframeStructure)
+  int getNTimeframes() const { return mTimeFrameStartIndex.size(); }
+
+  // the pair of first and last collision index belonging to a timeframe
+  std::pair<int, int> const& getTimeFrameIndexRange(int timeframeid, bool withQED = false) const { return withQED ? mTimeFrameStartIndexQED.at(timeframeid) : mTimeFrameStartIndex.at(timeframeid); }
+
+  // returns a new (small) context containing only the collisions of the given timeframe;
+  // meta information (prefixes, bunch filling, etc.) is kept, event part ids are unchanged
+  DigitizationContext extractSingleTimeframe(int timeframeid) const;
+
   // Sample and fix interaction vertices (according to some distribution). Makes sure that same event ids
   // have to have same vertex, as well as event ids associated to same collision.
   void sampleInteractionVertices(o2::dataformats::MeanVertexObject const& v);
@@ -138,6 +148,10 @@ class DigitizationContext
   // helper functions to save and load a context
   void saveToFile(std::string_view filename) const;
 
+  // save the context split into one (independently loadable) object per timeframe;
+  // the full context is written as well, so that the file can still be read with loadFromFile
+  void saveTimeframesToFile(std::string_view filename) const;
+
   // Return the vector of interaction vertices associated with collisions
   // The vector is empty if no vertices were provided or sampled. In this case, one
   // may call "sampleInteractionVertices".
@@ -145,6 +159,10 @@ class DigitizationContext
 
   static DigitizationContext* loadFromFile(std::string_view filename = "");
 
+  // load only the part of a context relevant for a single timeframe; works for files
+  // written with saveTimeframesToFile (only the timeframe is read) and saveToFile (full context is read and sliced)
+  static DigitizationContext* loadTimeframeFromFile(std::string_view filename, int timeframeid);
+
   void setCTPDigits(std::vector<o2::ctp::CTPDigit> const* ctpdigits) const
   {
     mCTPTrigger = ctpdigits;
@@ -15,7 +15,10 @@
 #include "DetectorsCommonDataFormats/DetectorNameConf.h"
 #include <TChain.h>
 #include <TFile.h>
+#include <TParameter.h>
+#include <fmt/format.h>
 #include <iostream>
+#include <memory>
 #include <numeric> // for iota
 #include <MathUtils/Cartesian.h>
 #include <DataFormatsCalibration/MeanVertexObject.h>
@@ -202,6 +205,23 @@ void DigitizationContext::saveToFile(std::string_view filename) const
   file.Close();
 }
 
+void DigitizationContext::saveTimeframesToFile(std::string_view filename) const
+{
+  TFile file(filename.data(), "RECREATE");
+  auto cl = TClass::GetClass(typeid(*this));
+  // the full context is kept as well, for the users of loadFromFile
+  file.WriteObjectAny(this, cl, "DigitizationContext");
+  int ntf = getNTimeframes();
+  for (int tf = 0; tf < ntf; ++tf) {
+    auto tfcontext = extractSingleTimeframe(tf);
+    file.WriteObjectAny(&tfcontext, cl, fmt::format("DigitizationContext_TF{}", tf).c_str());
+  }
+  // the number of timeframes serves as index/marker of the chunked format
+  TParameter<int> ntfparam("DigitizationContextNTimeframes", ntf);
+  ntfparam.Write();
+  file.Close();
+}
+
 DigitizationContext* DigitizationContext::loadFromFile(std::string_view filename)
 {
   std::string tmpFile;
@@ -215,6 +235,36 @@ DigitizationContext* DigitizationContext::loadFromFile(std::string_view filename
   return incontext;
 }
 
+DigitizationContext* DigitizationContext::loadTimeframeFromFile(std::string_view filename, int timeframeid)
+{
+  DigitizationContext* incontext = nullptr;
+  {
+    TFile file(filename.data(), "OPEN");
+    if (file.IsZombie()) {
+      LOG(error) << "Could not open collision context file " << filename;
+      return nullptr;
+    }
+    if (file.GetListOfKeys()->FindObject("DigitizationContextNTimeframes")) {
+      // chunked format: read only the requested timeframe
+      file.GetObject(fmt::format("DigitizationContext_TF{}", timeframeid).c_str(), incontext);
+      if (!incontext) {
+        LOG(error) << "Timeframe " << timeframeid << " not found in collision context file " << filename;
+      }
+      return incontext;
+    }
+  }
+  // monolithic format: read everything and keep only the timeframe asked
+  std::unique_ptr<DigitizationContext> fullcontext(loadFromFile(filename));
+  if (!fullcontext) {
+    return nullptr;
+  }
+  if (timeframeid < 0 || timeframeid >= fullcontext->getNTimeframes()) {
+    LOG(error) << "Timeframe " << timeframeid << " not found in collision context file " << filename;
+    return nullptr;
+  }
+  return new DigitizationContext(fullcontext->extractSingleTimeframe(timeframeid));
+}
+
 void DigitizationContext::fillQED(std::string_view QEDprefix, int max_events, double qedrate)
 {
   o2::steer::InteractionSampler qedInteractionSampler;
@@ -394,12 +444,51 @@ void DigitizationContext::applyMaxCollisionFilter(long startOrbit, long orbitsPe
 void DigitizationContext::finalizeTimeframeStructure(long startOrbit, long orbitsPerTF)
 {
   mTimeFrameStartIndex = getTimeFrameBoundaries(mEventRecords, startOrbit, orbitsPerTF);
+  mTimeFrameStartIndexQED = getTimeFrameBoundaries(mEventRecordsWithQED, startOrbit, orbitsPerTF);
   LOG(info) << "Fixed " << mTimeFrameStartIndex.size() << " timeframes ";
   for (auto p : mTimeFrameStartIndex) {
     LOG(info) << p.first << " " << p.second;
   }
 }
 
+DigitizationContext DigitizationContext::extractSingleTimeframe(int timeframeid) const
+{
+  DigitizationContext r;
+  // meta information is shared by all timeframes
+  r.mFirstOrbitForSampling = mFirstOrbitForSampling;
+  r.mMuBC = mMuBC;
+  r.mBCFilling = mBCFilling;
+  r.mSimPrefixes = mSimPrefixes;
+  r.mQEDSimPrefix = mQEDSimPrefix;
+  r.mDigitizerInteractionRate = mDigitizerInteractionRate;
+  r.mMaxPartNumber = mMaxPartNumber;
+
+  if (timeframeid < 0 || timeframeid >= mTimeFrameStartIndex.size()) {
+    LOG(error) << "Timeframe " << timeframeid << " not available in context with " << mTimeFrameStartIndex.size() << " timeframes";
+    return r;
+  }
+
+  auto copyRange = [](auto const& from, auto& to, std::pair<int, int> const& range) {
+    if (range.first <= range.second && range.second < from.size()) {
+      to.assign(from.begin() + range.first, from.begin() + range.second + 1);
+    }
+  };
+  const auto& range = mTimeFrameStartIndex[timeframeid];
+  copyRange(mEventRecords, r.mEventRecords, range);
+  copyRange(mEventParts, r.mEventParts, range);
+  copyRange(mInteractionVertices, r.mInteractionVertices, range);
+  r.mNofEntries = r.mEventRecords.size();
+  r.mTimeFrameStartIndex.emplace_back(0, r.mNofEntries - 1);
+
+  if (timeframeid < mTimeFrameStartIndexQED.size()) {
+    const auto& rangeQED = mTimeFrameStartIndexQED[timeframeid];
+    copyRange(mEventRecordsWithQED, r.mEventRecordsWithQED, rangeQED);
+    copyRange(mEventPartsWithQED, r.mEventPartsWithQED, rangeQED);
+    r.mTimeFrameStartIndexQED.emplace_back(0, (int)r.mEventRecordsWithQED.size() - 1);
+  }
+  return r;
+}
+
 std::unordered_map<int, int> DigitizationContext::getCollisionIndicesForSource(int source) const
 {
   // go through all collisions and pick those that have the give source
@@ -0,0 +1,88 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test DigitizationContext class
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include "SimulationDataFormat/DigitizationContext.h"
+#include <cstdio>
+#include <memory>
+
+using namespace o2::steer;
+
+namespace
+{
+// 10 collisions, 64 orbits apart, in timeframes of 128 orbits: 5 timeframes of 2 collisions
+DigitizationContext makeContext()
+{
+  DigitizationContext context;
+  context.setSimPrefixes({"o2sim"});
+  context.setMaxNumberParts(1);
+  for (int i = 0; i < 10; ++i) {
+    context.getEventRecords().emplace_back(o2::InteractionRecord{static_cast<uint16_t>(i), static_cast<uint32_t>(i * 64)}, 0.);
+    context.getEventParts().push_back({EventPart(0, i)});
+  }
+  context.setNCollisions(10);
+  context.finalizeTimeframeStructure(0, 128);
+  return context;
+}
+
+void checkSameCollisions(DigitizationContext const& a, DigitizationContext const& b)
+{
+  BOOST_REQUIRE_EQUAL(a.getNCollisions(), b.getNCollisions());
+  BOOST_REQUIRE_EQUAL(a.getEventRecords().size(), b.getEventRecords().size());
+  for (size_t i = 0; i < a.getEventRecords().size(); ++i) {
+    BOOST_CHECK(a.getEventRecords()[i] == b.getEventRecords()[i]);
+    BOOST_CHECK_EQUAL(a.getEventParts()[i][0].entryID, b.getEventParts()[i][0].entryID);
+  }
+  BOOST_CHECK_EQUAL(a.getNTimeframes(), b.getNTimeframes());
+  BOOST_CHECK(a.getSimPrefixes() == b.getSimPrefixes());
+}
+} // namespace
+
+BOOST_AUTO_TEST_CASE(DigitizationContext_roundtrip_full)
+{
+  auto context = makeContext();
+  BOOST_REQUIRE_EQUAL(context.getNTimeframes(), 5);
+  const char* filename = "testDigitizationContext_full.root";
+  context.saveToFile(filename);
+
+  std::unique_ptr<DigitizationContext> loaded(DigitizationContext::loadFromFile(filename));
+  BOOST_REQUIRE(loaded);
+  checkSameCollisions(context, *loaded);
+
+  std::unique_ptr<DigitizationContext> tf(DigitizationContext::loadTimeframeFromFile(filename, 3));
+  BOOST_REQUIRE(tf);
+  checkSameCollisions(context.extractSingleTimeframe(3), *tf);
+  std::remove(filename);
+}
+
+BOOST_AUTO_TEST_CASE(DigitizationContext_roundtrip_split)
+{
+  auto context = makeContext();
+  const char* filename = "testDigitizationContext_split.root";
+  context.saveTimeframesToFile(filename);
+
+  // the split file can still be read as a whole
+  std::unique_ptr<DigitizationContext> loaded(DigitizationContext::loadFromFile(filename));
+  BOOST_REQUIRE(loaded);
+  checkSameCollisions(context, *loaded);
+
+  for (int tfid = 0; tfid < context.getNTimeframes(); ++tfid) {
+    std::unique_ptr<DigitizationContext> tf(DigitizationContext::loadTimeframeFromFile(filename, tfid));
+    BOOST_REQUIRE(tf);
+    BOOST_CHECK_EQUAL(tf->getNCollisions(), 2);
+    checkSameCollisions(context.extractSingleTimeframe(tfid), *tf);
+  }
+  BOOST_CHECK(DigitizationContext::loadTimeframeFromFile(filename, 5) == nullptr);
+  std::remove(filename);
+}
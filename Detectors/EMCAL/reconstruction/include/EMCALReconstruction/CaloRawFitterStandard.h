@@ -21,8 +21,6 @@
 #include "EMCALReconstruction/Bunch.h"
 #include "EMCALReconstruction/CaloRawFitter.h"
 
-class TGraph;
-
 namespace o2
 {
 
@@ -30,7 +28,7 @@ namespace emcal
 {
 
 /// \class CaloRawFitterStandard
-/// \brief  Raw data fitting: standard TMinuit fit
+/// \brief  Raw data fitting: standard chi2 fit
 /// \ingroup EMCALreconstruction
 /// \author Hadi Hassan <hadi.hassan@cern.ch>, Oak Ridge National Laboratory
 /// \since November 4th, 2019
@@ -62,11 +60,11 @@ class CaloRawFitterStandard final : public CaloRawFitter
   /// \throw RawFitterError_t in case the fit failed (including all possible errors from upstream)
   CaloFitResults evaluate(const gsl::span<const Bunch> bunchvector) final;
 
-  /// \brief Fits the raw signal time distribution using TMinuit
+  /// \brief Fits the raw signal time distribution with the response function (amplitude profiled analytically, 1D search in time)
   /// \param firstTimeBin First timebin of the ALTRO bunch
   /// \param lastTimeBin Last timebin of the ALTRO bunch
   /// \return the fit parameters: amplitude, time, chi2
-  /// \throw RawFitter_t::FIT_ERROR in case the fit failed (insufficient number of samples or fit error from MINUIT)
+  /// \throw RawFitter_t::FIT_ERROR in case the fit failed (insufficient number of samples or non-finite chi2)
   std::tuple<float, float, float> fitRaw(int firstTimeBin, int lastTimeBin) const;
 
  private:
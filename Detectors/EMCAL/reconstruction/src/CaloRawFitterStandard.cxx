@@ -12,13 +12,14 @@
 /// \file CaloRawFitterStandard.cxx
 /// \author Hadi Hassan (hadi.hassan@cern.ch)
 
+#include <algorithm>
+#include <array>
+#include <cmath>
 #include <fairlogger/Logger.h>
 #include <random>
 
 // ROOT sytem
 #include "TMath.h"
-#include "TF1.h"
-#include "TGraph.h"
 
 #include "EMCALReconstruction/Bunch.h"
 #include "EMCALReconstruction/CaloFitResults.h"
@@ -103,41 +104,84 @@ CaloFitResults CaloRawFitterStandard::evaluate(const gsl::span<const Bunch> bunc
 
 std::tuple<float, float, float> CaloRawFitterStandard::fitRaw(int firstTimeBin, int lastTimeBin) const
 {
-
-  float amp(0), time(0), chi2(0);
-
+  // Least squares fit of amp * g(t - t0) with the fixed-shape response g (tau and order fixed, no pedestal), equal weights.
+  // The model is linear in the amplitude, which is therefore profiled analytically for every t0, so that only a 1D
+  // minimization of chi2(t0) remains. It is done by a grid scan within the same bounds as the previously used TF1/Minuit
+  // fit (t0 within +-4 bins and amp within [0.5, 2] of the starting values, taken at the maximum sample) followed by
+  // a golden section refinement. No allocations are done.
   int nsamples = lastTimeBin - firstTimeBin + 1;
   if (nsamples < 3) {
     throw RawFitterError_t::FIT_ERROR;
   }
 
-  TGraph gSig(nsamples);
-
+  std::array<double, constants::EMCAL_MAXTIMEBINS> xs, ys;
+  int imax = 0;
+  double syy = 0.;
   for (int i = 0; i < nsamples; i++) {
-    int timebin = firstTimeBin + i;
-    gSig.SetPoint(i, timebin, getReversed(timebin));
+    xs[i] = firstTimeBin + i;
+    ys[i] = getReversed(firstTimeBin + i);
+    syy += ys[i] * ys[i];
+    if (ys[i] > ys[imax]) {
+      imax = i;
+    }
   }
-
-  TF1 signalF("signal", CaloRawFitterStandard::rawResponseFunction, 0, constants::EMCAL_MAXTIMEBINS, 5);
-
-  signalF.SetParameters(10., 5., constants::TAU, constants::ORDER, 0.); // set all defaults once, just to be safe
-  signalF.SetParNames("amp", "t0", "tau", "N", "ped");
-  signalF.FixParameter(2, constants::TAU);
-  signalF.FixParameter(3, constants::ORDER);
-  signalF.FixParameter(4, 0);
-  signalF.SetParameter(1, time);
-  signalF.SetParameter(0, amp);
-  signalF.SetParLimits(0, 0.5 * amp, 2 * amp);
-  signalF.SetParLimits(1, time - 4, time + 4);
-
-  int status = gSig.Fit(&signalF, "QROW"); // Note option 'W': equal errors on all points
-  if (status == 0) {
-    amp = signalF.GetParameter(0);
-    time = signalF.GetParameter(1);
-    chi2 = signalF.GetChisquare();
-  } else {
+  const double ampStart = ys[imax], timeStart = xs[imax];
+  const double ampMin = ampStart > 0 ? 0.5 * ampStart : 2 * ampStart, ampMax = ampStart > 0 ? 2 * ampStart : 0.5 * ampStart;
+
+  // chi2 at given t0 for the best amplitude within the bounds
+  auto chi2AtTime = [&](double t0, double& amp) {
+    double syg = 0., sgg = 0.;
+    for (int i = 0; i < nsamples; i++) {
+      double xx = (xs[i] - t0 + constants::TAU) / constants::TAU;
+      if (xx > 0) {
+        double g = std::pow(xx, constants::ORDER) * std::exp(constants::ORDER * (1 - xx));
+        syg += ys[i] * g;
+        sgg += g * g;
+      }
+    }
+    amp = sgg > 0 ? std::clamp(syg / sgg, ampMin, ampMax) : ampStart;
+    return syy - 2 * amp * syg + amp * amp * sgg;
+  };
+
+  constexpr double TimeRange = 4., GridStep = 0.5, Precision = 1e-4;
+  const double tmin = timeStart - TimeRange, tmax = timeStart + TimeRange;
+  double tBest = timeStart, ampBest = ampStart, chi2Best = chi2AtTime(tBest, ampBest);
+  for (double t0 = tmin; t0 <= tmax; t0 += GridStep) {
+    double a, c2 = chi2AtTime(t0, a);
+    if (c2 < chi2Best) {
+      chi2Best = c2;
+      tBest = t0;
+      ampBest = a;
+    }
+  }
+  // golden section search in the bracket around the best grid point
+  constexpr double InvPhi = 0.6180339887498949;
+  double lo = std::max(tmin, tBest - GridStep), hi = std::min(tmax, tBest + GridStep);
+  double t1 = hi - InvPhi * (hi - lo), t2 = lo + InvPhi * (hi - lo), a1, a2;
+  double c1 = chi2AtTime(t1, a1), c2 = chi2AtTime(t2, a2);
+  while (hi - lo > Precision) {
+    if (c1 < c2) {
+      hi = t2;
+      t2 = t1;
+      c2 = c1;
+      t1 = hi - InvPhi * (hi - lo);
+      c1 = chi2AtTime(t1, a1);
+    } else {
+      lo = t1;
+      t1 = t2;
+      c1 = c2;
+      t2 = lo + InvPhi * (hi - lo);
+      c2 = chi2AtTime(t2, a2);
+    }
+  }
+  double tFit = 0.5 * (lo + hi), ampFit = 0., chi2Fit = chi2AtTime(tFit, ampFit);
+  if (chi2Best < chi2Fit) { // should not happen for the unimodal chi2 around the minimum, but be safe
+    tFit = tBest;
+    ampFit = ampBest;
+    chi2Fit = chi2Best;
+  }
+  if (!std::isfinite(chi2Fit)) {
     throw RawFitterError_t::FIT_ERROR;
   }
-
-  return std::make_tuple(amp, time, chi2);
+  return std::make_tuple(float(ampFit), float(tFit), float(chi2Fit));
 }
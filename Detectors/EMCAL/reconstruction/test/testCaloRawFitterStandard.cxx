@@ -0,0 +1,52 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#define BOOST_TEST_MODULE Test EMCAL Reconstruction
+#define BOOST_TEST_MAIN
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+#include <cmath>
+#include <vector>
+#include <DataFormatsEMCAL/Constants.h>
+#include <EMCALReconstruction/Bunch.h>
+#include <EMCALReconstruction/CaloRawFitterStandard.h>
+
+namespace o2
+{
+namespace emcal
+{
+
+BOOST_AUTO_TEST_CASE(CaloRawFitterStandard_test)
+{
+  CaloRawFitterStandard fitter;
+  fitter.setIsZeroSuppressed(true);
+
+  const int bunchlength = 15;
+  // peak times chosen in between samples, such that the maximum sample underestimates the amplitude
+  for (double truetime : {5.3, 6.5, 7.8}) {
+    for (double trueamp : {50., 500., 800.}) {
+      double par[5] = {trueamp, truetime, constants::TAU, constants::ORDER, 0.};
+      // samples are stored in the bunch starting from the last time bin
+      Bunch bunch(bunchlength, bunchlength - 1);
+      for (int i = bunchlength - 1; i >= 0; i--) {
+        double x = i;
+        bunch.addADC(static_cast<uint16_t>(std::round(CaloRawFitterStandard::rawResponseFunction(&x, par))));
+      }
+      std::vector<Bunch> bunches{bunch};
+      auto result = fitter.evaluate(bunches);
+      BOOST_CHECK_CLOSE(result.getAmp(), trueamp, 2.);
+      BOOST_CHECK_CLOSE(result.getTime(), truetime * constants::EMCAL_TIMESAMPLE, 1.);
+    }
+  }
+}
+
+} // namespace emcal
+} // namespace o2
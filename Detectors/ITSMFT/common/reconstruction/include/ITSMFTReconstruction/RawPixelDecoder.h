@@ -139,6 +139,7 @@ class RawPixelDecoder final : public PixelReader
 
  private:
   void setupLinks(o2::framework::InputRecord& inputs);
+  void updateRUDecodeOrder();
   int getRUEntrySW(int ruSW) const { return mRUEntry[ruSW]; }
   RUDecodeData* getRUDecode(int ruSW) { return &mRUDecodeVec[mRUEntry[ruSW]]; }
   GBTLink* getGBTLink(int i) { return i < 0 ? nullptr : &mGBTLinks[i]; }
@@ -150,6 +151,8 @@ class RawPixelDecoder final : public PixelReader
   std::unordered_map<uint32_t, LinkEntry> mSubsSpec2LinkID;                           // link subspec to link entry in the pool mapping
   std::vector<RUDecodeData> mRUDecodeVec;                                             // set of active RUs
   std::array<short, Mapping::getNRUs()> mRUEntry;                                     // entry of the RU with given SW ID in the mRUDecodeVec
+  std::array<uint32_t, Mapping::getNRUs()> mRUCostTF{};                               // decoding cost (fired pixels) of the RU with given SW ID in the current TF
+  std::vector<int> mRUDecodeOrder;                                                    // mRUDecodeVec entries in decreasing order of their cost in the previous TF
   std::vector<ChipPixelData*> mOrderedChipsPtr;                                       // special ordering helper used for the MFT (its chipID is not contiguous in RU)
   std::vector<PhysTrigger> mExtTriggers;                                              // external triggers
   GBTLink* mLinkForTriggers = nullptr;                                                // link assigned to collect the triggers
@@ -21,6 +21,7 @@
 #include "CommonUtils/StringUtils.h"
 #include "CommonUtils/VerbosityConfig.h"
 #include <filesystem>
+#include <numeric>
 
 #ifdef WITH_OPENMP
 #include <omp.h>
@@ -87,12 +88,15 @@ int RawPixelDecoder<Mapping>::decodeNextTrigger()
   }
   int nru = mRUDecodeVec.size();
   int prevNTrig = mExtTriggers.size();
+  if (int(mRUDecodeOrder.size()) != nru) {
+    updateRUDecodeOrder();
+  }
   do {
 #ifdef WITH_OPENMP
 #pragma omp parallel for schedule(dynamic) num_threads(mNThreads)
 #endif
-    for (int iru = 0; iru < nru; iru++) {
-      collectROFCableData(iru);
+    for (int i = 0; i < nru; i++) { // the most expensive RUs are processed first to reduce the tail of the dynamic schedule
+      collectROFCableData(mRUDecodeOrder[i]);
     }
 
     mROFCounter++;
@@ -105,11 +109,13 @@ int RawPixelDecoder<Mapping>::decodeNextTrigger()
 #pragma omp parallel for schedule(dynamic) num_threads(mNThreads) reduction(+ \
                                                                             : mNChipsFiredROF, mNPixelsFiredROF)
 #endif
-    for (int iru = 0; iru < nru; iru++) {
-      auto& ru = mRUDecodeVec[iru];
+    for (int i = 0; i < nru; i++) {
+      auto& ru = mRUDecodeVec[mRUDecodeOrder[i]];
       if (ru.nNonEmptyLinks) {
         ru.ROFRampUpStage = mROFRampUpStage;
-        mNPixelsFiredROF += ru.decodeROF(mMAP, mInteractionRecord, mVerifyDecoder);
+        auto nPix = ru.decodeROF(mMAP, mInteractionRecord, mVerifyDecoder);
+        mRUCostTF[ru.ruSWID] += nPix + 1; // every RU has its own slot, no concurrent updates
+        mNPixelsFiredROF += nPix;
         mNChipsFiredROF += ru.nChipsFired;
       } else {
         ru.clearSeenChipIDs();
@@ -150,11 +156,27 @@ void RawPixelDecoder<Mapping>::startNewTF(InputRecord& inputs)
     ru.nLinksDone = 0;
   }
   setupLinks(inputs);
+  updateRUDecodeOrder();
   mNLinksDone = 0;
   mExtTriggers.clear();
   mTimerTFStart.Stop();
 }
 
+///______________________________________________________________
+/// Order RUs in decreasing decoding cost seen in the previous TF, reset the costs for the new TF
+template <class Mapping>
+void RawPixelDecoder<Mapping>::updateRUDecodeOrder()
+{
+  // The RU load is very unbalanced (e.g. inner vs outer barrel), with the dynamic scheduling of the decoding
+  // threads starting from the heaviest RUs avoids ending the ROF with a single thread decoding a big RU
+  mRUDecodeOrder.resize(mRUDecodeVec.size());
+  std::iota(mRUDecodeOrder.begin(), mRUDecodeOrder.end(), 0);
+  std::stable_sort(mRUDecodeOrder.begin(), mRUDecodeOrder.end(), [this](int a, int b) {
+    return mRUCostTF[mRUDecodeVec[a].ruSWID] > mRUCostTF[mRUDecodeVec[b].ruSWID];
+  });
+  mRUCostTF.fill(0);
+}
+
 ///______________________________________________________________
 /// Collect cable data for the next ROF for given RU
 template <class Mapping>
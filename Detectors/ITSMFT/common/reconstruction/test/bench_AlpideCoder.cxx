@@ -0,0 +1,79 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+/// \file bench_AlpideCoder.cxx
+/// \brief Benchmark of the ALPIDE cable data decoding throughput
+
+#include "benchmark/benchmark.h"
+#include <algorithm>
+#include <random>
+#include <vector>
+#include "ITSMFTReconstruction/AlpideCoder.h"
+#include "ITSMFTReconstruction/PayLoadCont.h"
+#include "ITSMFTReconstruction/PixelData.h"
+
+using namespace o2::itsmft;
+
+// fill the cable buffer with nROFs frames of nChips chips, each with nHits random (possibly clustered) hits
+void fillCableData(PayLoadCont& buffer, int nROFs, int nChips, int nHits, int clusterSize)
+{
+  std::mt19937 gen(12345);
+  std::uniform_int_distribution<int> rowGen(0, AlpideCoder::NRows - 1 - clusterSize), colGen(0, AlpideCoder::NCols - 1 - clusterSize);
+  AlpideCoder coder;
+  ChipPixelData chip;
+  for (int irof = 0; irof < nROFs; irof++) {
+    for (int ich = 0; ich < nChips; ich++) {
+      chip.clear();
+      auto& pixels = chip.getData();
+      for (int ih = 0; ih < nHits; ih += clusterSize * clusterSize) {
+        int row = rowGen(gen), col = colGen(gen);
+        for (int dr = 0; dr < clusterSize; dr++) {
+          for (int dc = 0; dc < clusterSize; dc++) {
+            pixels.emplace_back(row + dr, col + dc);
+          }
+        }
+      }
+      std::sort(pixels.begin(), pixels.end(), [](const PixelData& a, const PixelData& b) { return a.getRow() < b.getRow() || (a.getRow() == b.getRow() && a.getCol() < b.getCol()); });
+      pixels.erase(std::unique(pixels.begin(), pixels.end(), [](const PixelData& a, const PixelData& b) { return a.getRow() == b.getRow() && a.getCol() == b.getCol(); }), pixels.end());
+      buffer.ensureFreeCapacity(40 * (pixels.size() + 10));
+      coder.encodeChip(buffer, chip, ich, 0);
+    }
+  }
+}
+
+static void BM_DecodeCable(benchmark::State& state)
+{
+  PayLoadCont buffer;
+  fillCableData(buffer, 100, 9, state.range(0), state.range(1));
+  ChipPixelData chip;
+  std::vector<uint16_t> seenChips;
+  auto chipIDGetter = [](int cid) { return cid; };
+  size_t nHits = 0;
+  for (auto _ : state) {
+    buffer.rewind();
+    seenChips.clear();
+    int ret = 0;
+    while ((ret = AlpideCoder::decodeChip(chip, buffer, seenChips, chipIDGetter)) || chip.isErrorSet()) {
+      nHits += chip.getData().size();
+      if (ret < 0) {
+        break;
+      }
+    }
+    benchmark::DoNotOptimize(nHits);
+  }
+  state.SetBytesProcessed(int64_t(state.iterations()) * buffer.getSize());
+  state.counters["hits"] = benchmark::Counter(nHits, benchmark::Counter::kIsRate);
+}
+
+// hits per chip, cluster size (side of the square of fired pixels, 1 gives mostly DATA SHORT words)
+BENCHMARK(BM_DecodeCable)->Args({10, 1})->Args({100, 1})->Args({100, 2})->Args({1000, 2})->Args({1000, 3})->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
@@ -26,6 +26,7 @@
 #include <gsl/span>
 
 #include <TH2D.h>
+#include <TRandom3.h>
 
 #include "DataFormatsMCH/Digit.h"
 #include "DataFormatsMCH/Cluster.h"
@@ -135,6 +136,8 @@ class ClusterFinderOriginal
   ErrorMap mErrorMap{}; ///< counting of encountered errors
 
   PreClusterFinder mPreClusterFinder{}; ///< preclusterizer
+
+  mutable TRandom3 mRandom{1}; ///< random generator used in the fit, seeded from each precluster
 };
 
 } // namespace mch
@@ -31,7 +31,6 @@
 #include <TH2I.h>
 #include <TAxis.h>
 #include <TMath.h>
-#include <TRandom.h>
 
 #include <fairlogger/Logger.h>
 
@@ -135,6 +134,14 @@ void ClusterFinderOriginal::findClusters(gsl::span<const Digit> digits)
   // set the Mathieson function to be used
   mMathieson = (digits[0].getDetID() < 300) ? &mMathiesons[0] : &mMathiesons[1];
 
+  // seed the random generator from the precluster content, so that the result does not
+  // depend on the other preclusters processed before by this clusterizer
+  uint32_t seed = digits[0].getDetID();
+  for (const auto& digit : digits) {
+    seed = seed * 31 + digit.getPadID();
+  }
+  mRandom.SetSeed(seed == 0 ? 1 : seed);
+
   // reset the current precluster being processed
   resetPreCluster(digits);
 
@@ -1621,7 +1628,7 @@ double ClusterFinderOriginal::fit(double currentParam[SNFitParamMax + 2],
       }
       if (nFail > 10) {
         currentParam[iDerivMax] -= shift[iDerivMax];
-        shift[iDerivMax] = 4. * shiftSave * (gRandom->Rndm(0) - 0.5);
+        shift[iDerivMax] = 4. * shiftSave * (mRandom.Rndm() - 0.5);
         currentParam[iDerivMax] += shift[iDerivMax];
       }
     }
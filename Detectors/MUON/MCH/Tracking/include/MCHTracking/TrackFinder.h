@@ -18,8 +18,6 @@
 #define O2_MCH_TRACKFINDER_H_
 
 #include <chrono>
-#include <unordered_map>
-#include <unordered_set>
 #include <list>
 #include <array>
 #include <vector>
@@ -64,7 +62,37 @@ class TrackFinder
   void printTimers() const;
 
  private:
-  const std::list<Track>& findTracks(const std::unordered_map<int, std::list<const Cluster*>>& clusters);
+  /// set of clusters excluded from the search, flagged by their index in the current TF
+  class ClusterIds
+  {
+   public:
+    explicit ClusterIds(std::size_t nClusters) : mFlags(nClusters, false) {}
+    /// return true if no cluster is excluded
+    bool empty() const { return mIndices.empty(); }
+    /// return true if the cluster at this index is excluded
+    bool contains(uint32_t index) const { return mFlags[index]; }
+    /// exclude the cluster at this index if not already done
+    void insert(uint32_t index)
+    {
+      if (!mFlags[index]) {
+        mFlags[index] = true;
+        mIndices.push_back(index);
+      }
+    }
+    /// move the excluded clusters into destination and leave this set empty
+    void moveTo(ClusterIds& destination)
+    {
+      for (auto index : mIndices) {
+        destination.insert(index);
+        mFlags[index] = false;
+      }
+      mIndices.clear();
+    }
+
+   private:
+    std::vector<bool> mFlags{};       ///< one flag per cluster of the TF
+    std::vector<uint32_t> mIndices{}; ///< indices of the flagged clusters
+  };
 
   void findTrackCandidates();
   void findTrackCandidatesInSt5();
@@ -75,13 +103,13 @@ class TrackFinder
   std::list<Track>::iterator followTrackInOverlapDE(const std::list<Track>::iterator& itTrack, int currentDE, int plane);
   std::list<Track>::iterator followTrackInChamber(std::list<Track>::iterator& itTrack,
                                                   int chamber, int lastChamber, bool canSkip,
-                                                  std::unordered_map<int, std::unordered_set<uint32_t>>& excludedClusters);
+                                                  ClusterIds& excludedClusters);
   std::list<Track>::iterator followTrackInChamber(std::list<Track>::iterator& itTrack,
                                                   int plane1, int plane2, int lastChamber,
-                                                  std::unordered_map<int, std::unordered_set<uint32_t>>& excludedClusters);
+                                                  ClusterIds& excludedClusters);
   std::list<Track>::iterator addClustersAndFollowTrack(std::list<Track>::iterator& itTrack, const TrackParam& paramAtCluster1,
                                                        const TrackParam* paramAtCluster2, int nextChamber, int lastChamber,
-                                                       std::unordered_map<int, std::unordered_set<uint32_t>>& excludedClusters);
+                                                       ClusterIds& excludedClusters);
 
   void improveTracks();
 
@@ -102,10 +130,22 @@ class TrackFinder
   bool propagateCurrentParam(Track& track, int chamber);
 
   bool areUsed(const Cluster& cl1, const Cluster& cl2, const std::vector<std::array<uint32_t, 4>>& usedClusters);
-  void excludeClustersFromIdenticalTracks(const std::array<uint32_t, 4>& currentClusters,
-                                          const std::vector<std::array<uint32_t, 8>>& usedClusters,
-                                          std::unordered_map<int, std::unordered_set<uint32_t>>& excludedClusters);
-  void moveClusters(std::unordered_map<int, std::unordered_set<uint32_t>>& source, std::unordered_map<int, std::unordered_set<uint32_t>>& destination);
+  void excludeClustersFromIdenticalTracks(const std::array<const Cluster*, 4>& currentClusters,
+                                          const std::vector<std::array<const Cluster*, 8>>& usedClusters,
+                                          ClusterIds& excludedClusters);
+  void moveClusters(ClusterIds& source, ClusterIds& destination) { source.moveTo(destination); }
+  /// return an empty set of excluded clusters sized for the current TF
+  ClusterIds noExcludedClusters() const { return ClusterIds(mInputClusters.size()); }
+  /// return true if the cluster is in the set
+  bool isExcluded(const Cluster& cluster, const ClusterIds& excludedClusters) const
+  {
+    return excludedClusters.contains(&cluster - mInputClusters.data());
+  }
+  /// add the cluster to the set if not already there
+  void exclude(const Cluster& cluster, ClusterIds& excludedClusters) const
+  {
+    excludedClusters.insert(&cluster - mInputClusters.data());
+  }
 
   bool isCompatible(const TrackParam& param, const Cluster& cluster, TrackParam& paramAtCluster);
   bool tryOneClusterFast(const TrackParam& param, const Cluster& cluster);
@@ -138,8 +178,12 @@ class TrackFinder
 
   TrackFitter mTrackFitter{}; /// track fitter
 
-  /// array of pointers to the lists of clusters per DE
-  std::array<std::vector<std::pair<const int, const std::list<const Cluster*>*>>, 32> mClusters{};
+  /// array of DE per plane, each with its clusters (a view into mSortedClusters)
+  std::array<std::vector<std::pair<const int, gsl::span<const Cluster* const>>>, 32> mClusters{};
+  static constexpr int SNDEIds = 2048;                      ///< DE IDs are coded on 11 bits of the cluster uid
+  gsl::span<const Cluster> mInputClusters{};                ///< clusters of the current TF
+  std::vector<const Cluster*> mSortedClusters{};            ///< pointers to the clusters grouped per DE
+  std::array<std::size_t, SNDEIds + 1> mDEClusterOffsets{}; ///< offset of the clusters of each DE in mSortedClusters
 
   std::list<Track> mTracks{}; ///< list of reconstructed tracks
 
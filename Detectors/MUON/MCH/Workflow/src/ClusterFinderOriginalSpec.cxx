@@ -16,15 +16,20 @@
 
 #include "MCHWorkflow/ClusterFinderOriginalSpec.h"
 
+#include <algorithm>
 #include <iostream>
 #include <fstream>
 #include <chrono>
+#include <memory>
 #include <vector>
 #include <stdexcept>
 #include <string>
 
 #include <gsl/span>
 
+#include <TH1.h>
+#include <TROOT.h>
+
 #include "Framework/CallbackService.h"
 #include "Framework/ConfigParamRegistry.h"
 #include "Framework/ControlService.h"
@@ -43,6 +48,10 @@
 #include "DataFormatsMCH/Cluster.h"
 #include "MCHClustering/ClusterFinderOriginal.h"
 
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
+
 namespace o2
 {
 namespace mch
@@ -65,7 +74,25 @@ class ClusterFinderOriginalTask
       o2::conf::ConfigurableParam::updateFromFile(config, "MCHClustering", true);
     }
     bool run2Config = ic.options().get<bool>("run2-config");
-    mClusterFinder.init(run2Config);
+
+    mNThreads = std::max(1, ic.options().get<int>("nthreads"));
+#ifndef WITH_OPENMP
+    if (mNThreads > 1) {
+      LOGP(warning, "Built without OpenMP, clustering with 1 thread instead of {}", mNThreads);
+      mNThreads = 1;
+    }
+#endif
+    if (mNThreads > 1) {
+      // the clusterizer uses temporary histograms: they must not be registered in the current directory
+      ROOT::EnableThreadSafety();
+      TH1::AddDirectory(false);
+    }
+    mClusterFinders.clear();
+    for (int i = 0; i < mNThreads; ++i) {
+      mClusterFinders.emplace_back(std::make_unique<ClusterFinderOriginal>())->init(run2Config);
+    }
+    mThreadOutputs.resize(mNThreads);
+    LOGP(info, "clustering with {} thread(s)", mNThreads);
 
     mAttachInitalPrecluster = ic.options().get<bool>("attach-initial-precluster");
 
@@ -75,7 +102,9 @@ class ClusterFinderOriginalTask
       mErrorMap.forEach([](Error error) {
         LOGP(warning, fmt::runtime(error.asString()));
       });
-      this->mClusterFinder.deinit();
+      for (auto& clusterFinder : this->mClusterFinders) {
+        clusterFinder->deinit();
+      }
     });
   }
 
@@ -95,67 +124,131 @@ class ClusterFinderOriginalTask
     auto& usedDigits = pc.outputs().make<std::vector<Digit>>(OutputRef{"clusterdigits"});
 
     clusterROFs.reserve(preClusterROFs.size());
-    auto& errorMap = mClusterFinder.getErrorMap();
-    errorMap.clear();
+    for (auto& clusterFinder : mClusterFinders) {
+      clusterFinder->getErrorMap().clear();
+    }
+
+    int nThreads = std::min(mNThreads, static_cast<int>(preClusterROFs.size()));
+    if (nThreads <= 1) {
+      clusterize(*mClusterFinders[0], preClusterROFs, preClusters, digits, clusterROFs, clusters, usedDigits, mTimeClusterFinder);
+    } else {
+      // the ROFs are independent: each thread clusterizes a contiguous block of them with its own clusterizer,
+      // then the outputs are concatenated in the order of the blocks so that the result does not depend on the
+      // number of threads
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(static, 1) num_threads(nThreads)
+#endif
+      for (int iThread = 0; iThread < nThreads; ++iThread) {
+        auto& output = mThreadOutputs[iThread];
+        output.clear();
+        size_t first = preClusterROFs.size() * iThread / nThreads;
+        size_t last = preClusterROFs.size() * (iThread + 1) / nThreads;
+        clusterize(*mClusterFinders[iThread], preClusterROFs.subspan(first, last - first), preClusters, digits,
+                   output.clusterROFs, output.clusters, output.usedDigits, output.time);
+      }
+      for (int iThread = 0; iThread < nThreads; ++iThread) {
+        auto& output = mThreadOutputs[iThread];
+        auto clusterOffset = clusters.size();
+        auto digitOffset = usedDigits.size();
+        for (const auto& rof : output.clusterROFs) {
+          clusterROFs.emplace_back(rof.getBCData(), rof.getFirstIdx() + clusterOffset, rof.getNEntries(), rof.getBCWidth());
+        }
+        clusters.insert(clusters.end(), output.clusters.begin(), output.clusters.end());
+        for (auto itCluster = clusters.begin() + clusterOffset; itCluster < clusters.end(); ++itCluster) {
+          itCluster->firstDigit += digitOffset;
+        }
+        usedDigits.insert(usedDigits.end(), output.usedDigits.begin(), output.usedDigits.end());
+        mTimeClusterFinder += output.time;
+      }
+    }
+
+    // create the output message for clustering errors
+    ErrorMap errorMap{};
+    for (auto& clusterFinder : mClusterFinders) {
+      errorMap.add(clusterFinder->getErrorMap());
+    }
+    auto& clusterErrors = pc.outputs().make<std::vector<Error>>(OutputRef{"clustererrors"});
+    errorMap.forEach([&clusterErrors](Error error) {
+      clusterErrors.emplace_back(error);
+    });
+    mErrorMap.add(errorMap);
+
+    LOGP(info, "Found {:4d} clusters from {:4d} preclusters in {:2d} ROFs",
+         clusters.size(), preClusters.size(), preClusterROFs.size());
+  }
+
+ private:
+  /// clusters and attached digits produced by one thread, with references local to these vectors
+  struct ThreadOutput {
+    std::vector<ROFRecord> clusterROFs{};
+    std::vector<Cluster> clusters{};
+    std::vector<Digit> usedDigits{};
+    std::chrono::duration<double> time{};
+    void clear()
+    {
+      clusterROFs.clear();
+      clusters.clear();
+      usedDigits.clear();
+      time = std::chrono::duration<double>{};
+    }
+  };
+
+  //_________________________________________________________________________________________________
+  template <typename ROFs, typename Clusters, typename Digits>
+  void clusterize(ClusterFinderOriginal& clusterFinder, gsl::span<const ROFRecord> preClusterROFs,
+                  gsl::span<const PreCluster> preClusters, gsl::span<const Digit> digits,
+                  ROFs& clusterROFs, Clusters& clusters, Digits& usedDigits, std::chrono::duration<double>& time) const
+  {
+    /// clusterize the given ROFs and fill the output vectors
+
     for (const auto& preClusterROF : preClusterROFs) {
 
       // prepare to clusterize the current ROF
       auto clusterOffset = clusters.size();
-      mClusterFinder.reset();
+      clusterFinder.reset();
 
       for (const auto& preCluster : preClusters.subspan(preClusterROF.getFirstIdx(), preClusterROF.getNEntries())) {
 
         auto preclusterDigits = digits.subspan(preCluster.firstDigit, preCluster.nDigits);
-        auto firstClusterIdx = mClusterFinder.getClusters().size();
+        auto firstClusterIdx = clusterFinder.getClusters().size();
 
         // clusterize the current precluster
         auto tStart = std::chrono::high_resolution_clock::now();
-        mClusterFinder.findClusters(preclusterDigits);
+        clusterFinder.findClusters(preclusterDigits);
         auto tEnd = std::chrono::high_resolution_clock::now();
-        mTimeClusterFinder += tEnd - tStart;
+        time += tEnd - tStart;
 
         if (mAttachInitalPrecluster) {
           // store the new clusters and associate them to all the digits of the precluster
-          writeClusters(preclusterDigits, firstClusterIdx, clusters, usedDigits);
+          writeClusters(clusterFinder, preclusterDigits, firstClusterIdx, clusters, usedDigits);
         }
       }
 
       if (!mAttachInitalPrecluster) {
         // store all the clusters of the current ROF and the associated digits actually used in the clustering
-        writeClusters(clusters, usedDigits);
+        writeClusters(clusterFinder, clusters, usedDigits);
       }
 
       // create the cluster ROF
       clusterROFs.emplace_back(preClusterROF.getBCData(), clusterOffset, clusters.size() - clusterOffset,
                                preClusterROF.getBCWidth());
     }
-
-    // create the output message for clustering errors
-    auto& clusterErrors = pc.outputs().make<std::vector<Error>>(OutputRef{"clustererrors"});
-    errorMap.forEach([&clusterErrors](Error error) {
-      clusterErrors.emplace_back(error);
-    });
-    mErrorMap.add(errorMap);
-
-    LOGP(info, "Found {:4d} clusters from {:4d} preclusters in {:2d} ROFs",
-         clusters.size(), preClusters.size(), preClusterROFs.size());
   }
 
- private:
   //_________________________________________________________________________________________________
-  void writeClusters(const gsl::span<const Digit>& preclusterDigits, size_t firstClusterIdx,
-                     std::vector<Cluster, o2::pmr::polymorphic_allocator<Cluster>>& clusters,
-                     std::vector<Digit, o2::pmr::polymorphic_allocator<Digit>>& usedDigits) const
+  template <typename Clusters, typename Digits>
+  void writeClusters(const ClusterFinderOriginal& clusterFinder, const gsl::span<const Digit>& preclusterDigits,
+                     size_t firstClusterIdx, Clusters& clusters, Digits& usedDigits) const
   {
     /// fill the output messages with the new clusters and all the digits from the corresponding precluster
     /// modify the references to the attached digits according to their position in the global vector
 
-    if (firstClusterIdx == mClusterFinder.getClusters().size()) {
+    if (firstClusterIdx == clusterFinder.getClusters().size()) {
       return;
     }
 
     auto clusterOffset = clusters.size();
-    clusters.insert(clusters.end(), mClusterFinder.getClusters().begin() + firstClusterIdx, mClusterFinder.getClusters().end());
+    clusters.insert(clusters.end(), clusterFinder.getClusters().begin() + firstClusterIdx, clusterFinder.getClusters().end());
 
     auto digitOffset = usedDigits.size();
     usedDigits.insert(usedDigits.end(), preclusterDigits.begin(), preclusterDigits.end());
@@ -167,27 +260,29 @@ class ClusterFinderOriginalTask
   }
 
   //_________________________________________________________________________________________________
-  void writeClusters(std::vector<Cluster, o2::pmr::polymorphic_allocator<Cluster>>& clusters,
-                     std::vector<Digit, o2::pmr::polymorphic_allocator<Digit>>& usedDigits) const
+  template <typename Clusters, typename Digits>
+  void writeClusters(const ClusterFinderOriginal& clusterFinder, Clusters& clusters, Digits& usedDigits) const
   {
     /// fill the output messages with clusters and attached digits of the current event
     /// modify the references to the attached digits according to their position in the global vector
 
     auto clusterOffset = clusters.size();
-    clusters.insert(clusters.end(), mClusterFinder.getClusters().begin(), mClusterFinder.getClusters().end());
+    clusters.insert(clusters.end(), clusterFinder.getClusters().begin(), clusterFinder.getClusters().end());
 
     auto digitOffset = usedDigits.size();
-    usedDigits.insert(usedDigits.end(), mClusterFinder.getUsedDigits().begin(), mClusterFinder.getUsedDigits().end());
+    usedDigits.insert(usedDigits.end(), clusterFinder.getUsedDigits().begin(), clusterFinder.getUsedDigits().end());
 
     for (auto itCluster = clusters.begin() + clusterOffset; itCluster < clusters.end(); ++itCluster) {
       itCluster->firstDigit += digitOffset;
     }
   }
 
-  bool mAttachInitalPrecluster = false;               ///< attach all digits of initial precluster to cluster
-  ClusterFinderOriginal mClusterFinder{};             ///< clusterizer
-  ErrorMap mErrorMap{};                               ///< counting of encountered errors
-  std::chrono::duration<double> mTimeClusterFinder{}; ///< timer
+  bool mAttachInitalPrecluster = false;                                ///< attach all digits of initial precluster to cluster
+  int mNThreads = 1;                                                   ///< number of clustering threads
+  std::vector<std::unique_ptr<ClusterFinderOriginal>> mClusterFinders; ///< clusterizers, one per thread
+  std::vector<ThreadOutput> mThreadOutputs{};                          ///< outputs of the clustering threads
+  ErrorMap mErrorMap{};                                                ///< counting of encountered errors
+  std::chrono::duration<double> mTimeClusterFinder{};                  ///< timer
 };
 
 //_________________________________________________________________________________________________
@@ -205,7 +300,8 @@ o2::framework::DataProcessorSpec getClusterFinderOriginalSpec(const char* specNa
     AlgorithmSpec{adaptFromTask<ClusterFinderOriginalTask>()},
     Options{{"mch-config", VariantType::String, "", {"JSON or INI file with clustering parameters"}},
             {"run2-config", VariantType::Bool, false, {"setup for run2 data"}},
-            {"attach-initial-precluster", VariantType::Bool, false, {"attach all digits of initial precluster to cluster"}}}};
+            {"attach-initial-precluster", VariantType::Bool, false, {"attach all digits of initial precluster to cluster"}},
+            {"nthreads", VariantType::Int, 1, {"number of threads clusterizing different ROFs in parallel"}}}};
 }
 
 } // end namespace mch
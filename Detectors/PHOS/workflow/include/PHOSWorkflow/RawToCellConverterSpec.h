@@ -10,6 +10,9 @@
 // or submit itself to any jurisdiction.
 
 #include <vector>
+#include <gsl/span>
+
+#include "CommonDataFormat/InteractionRecord.h"
 
 #include "Framework/DataProcessorSpec.h"
 #include "Framework/Task.h"
@@ -60,6 +63,40 @@ class RawToCellConverterSpec : public framework::Task
   void run(framework::ProcessingContext& ctx) final;
 
  protected:
+  /// \brief Cells of one DMA page, as ranges in the cell containers of DecodedLink
+  struct DecodedPage {
+    o2::InteractionRecord ir; ///< interaction record (corrected for the LM-L0 latency)
+    short ddl = 0;            ///< DDL of the page
+    int cellFirst = 0;        ///< first cell of the page
+    int cellLast = 0;         ///< end of the cell range of the page
+    int truFirst = 0;         ///< first TRU cell of the page
+    int truLast = 0;          ///< end of the TRU cell range of the page
+  };
+
+  /// \brief Decoding output of one input message (link), filled independently by the decoding threads
+  struct DecodedLink {
+    std::vector<DecodedPage> pages;             ///< accepted pages in the order of the raw data
+    std::vector<Cell> cells;                    ///< cells of all pages, sorted by absId within each page
+    std::vector<Cell> tru;                      ///< TRU cells of all pages, sorted by TRU id within each page
+    std::vector<o2::phos::RawReaderError> errs; ///< errors in the order they were found
+    std::vector<short> chi2;                    ///< fit qualities
+    void clear()
+    {
+      pages.clear();
+      cells.clear();
+      tru.clear();
+      errs.clear();
+      chi2.clear();
+    }
+  };
+
+  /// \brief Decode all pages of one input message
+  /// \param rawmemory payload of the message
+  /// \param tfOrbitFirst first orbit of the TF, to reject data of the previous TF
+  /// \param ithread index of the thread-local decoder and fitter to use
+  /// \param output container for the decoded cells and errors
+  void decodeLink(gsl::span<const char> rawmemory, uint32_t tfOrbitFirst, int ithread, DecodedLink& output);
+
  private:
   bool mFillChi2 = false;                                     ///< Fill output with quality of samples
   bool mCombineGHLG = true;                                   ///< Combine or not HG and LG channels (def: combine, LED runs: not combine)
@@ -67,9 +104,11 @@ class RawToCellConverterSpec : public framework::Task
   bool mKeepTrigNoise = false;                                ///< Keep all trigger digits and summary tables for noise scan
   bool mInitSimParams = true;                                 ///< Sim/RecoParams to be initialized
   int mLastSize = 0;                                          ///< size of last send list of cells to reserve same in next bunch
+  int mNThreads = 1;                                          ///< number of decoding threads
   unsigned int mflpId = 0;                                    ///< subspec of output stream
-  std::unique_ptr<AltroDecoder> mDecoder;                     ///!<! Raw decoder
-  std::unique_ptr<CaloRawFitter> mRawFitter;                  ///!<! Raw fitter
+  std::vector<std::unique_ptr<AltroDecoder>> mDecoders;       ///!<! Raw decoders, one per thread
+  std::vector<std::unique_ptr<CaloRawFitter>> mRawFitters;    ///!<! Raw fitters, one per thread
+  std::vector<DecodedLink> mDecodedLinks;                     ///< per input message decoding output, reused between TFs
   std::array<std::vector<Cell>, 14> mTmpCells;                ///< Temporary cells storage to all 14 DLL
   std::array<std::vector<Cell>, 14> mTmpTRU;                  ///< Temporary tru cells storage to all 14 DLL
   std::vector<o2::phos::Cell> mOutputCells;                   ///< Container with output cells
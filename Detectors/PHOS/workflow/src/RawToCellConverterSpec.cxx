@@ -8,6 +8,7 @@
 // In applying this license CERN does not waive the privileges and immunities
 // granted to it by virtue of its status as an Intergovernmental Organization
 // or submit itself to any jurisdiction.
+#include <algorithm>
 #include <string>
 #include <fairlogger/Logger.h>
 #include "CommonDataFormat/InteractionRecord.h"
@@ -30,6 +31,10 @@
 #include "CommonUtils/VerbosityConfig.h"
 #include "DataFormatsCTP/TriggerOffsetsParam.h"
 
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
+
 using namespace o2::phos::reco_workflow;
 
 void RawToCellConverterSpec::init(framework::InitContext& ctx)
@@ -39,14 +44,20 @@ void RawToCellConverterSpec::init(framework::InitContext& ctx)
   auto path = ctx.options().get<std::string>("mappingpath");
   Mapping::Instance(path);
 
+  mNThreads = std::max(1, ctx.options().get<int>("nthreads"));
+#ifndef WITH_OPENMP
+  if (mNThreads > 1) {
+    LOG(warning) << "Built without OpenMP, decoding with 1 thread instead of " << mNThreads;
+    mNThreads = 1;
+  }
+#endif
+
   auto fitmethod = ctx.options().get<std::string>("fitmethod");
   if (fitmethod == "default") {
     LOG(info) << "Using default raw fitter";
-    mRawFitter = std::unique_ptr<o2::phos::CaloRawFitter>(new o2::phos::CaloRawFitter);
   }
   if (fitmethod == "semigaus") {
     LOG(info) << "Using SemiGauss raw fitter";
-    mRawFitter = std::unique_ptr<o2::phos::CaloRawFitter>(new o2::phos::CaloRawFitterGS);
   }
 
   mFillChi2 = (ctx.options().get<std::string>("fillchi2").compare("on") == 0);
@@ -54,29 +65,46 @@ void RawToCellConverterSpec::init(framework::InitContext& ctx)
     LOG(info) << "Fit quality output will be filled";
   }
 
-  mDecoder = std::make_unique<AltroDecoder>();
-
   mPedestalRun = (ctx.options().get<std::string>("pedestal").compare("on") == 0);
   if (mPedestalRun) {
-    mRawFitter->setPedestal();
-    mDecoder->setPedestalRun(); // sets also keeping both HG and LG channels
     LOG(info) << "Pedestal run will be processed";
   }
 
   mCombineGHLG = (ctx.options().get<std::string>("keepHGLG").compare("on") != 0);
   if (!mCombineGHLG) {
-    mDecoder->setCombineHGLG(false);
     LOG(info) << "Both HighGain and LowGain will be kept";
   }
   int presamples = ctx.options().get<int>("presamples");
-  mDecoder->setPresamples(presamples);
   LOG(info) << "Using " << presamples << " pre-samples";
 
   mKeepTrigNoise = (ctx.options().get<std::string>("keeptrig").compare("on") == 0);
   if (mKeepTrigNoise) {
-    mDecoder->setKeepTruNoise(mKeepTrigNoise);
     LOG(info) << "Both trigger digits and summary tables will be kept";
   }
+
+  // decoders and fitters keep per-channel state, each decoding thread gets its own
+  mDecoders.clear();
+  mRawFitters.clear();
+  for (int ith = 0; ith < mNThreads; ith++) {
+    if (fitmethod == "semigaus") {
+      mRawFitters.emplace_back(new o2::phos::CaloRawFitterGS);
+    } else {
+      mRawFitters.emplace_back(new o2::phos::CaloRawFitter);
+    }
+    auto& decoder = mDecoders.emplace_back(std::make_unique<AltroDecoder>());
+    if (mPedestalRun) {
+      mRawFitters.back()->setPedestal();
+      decoder->setPedestalRun(); // sets also keeping both HG and LG channels
+    }
+    if (!mCombineGHLG) {
+      decoder->setCombineHGLG(false);
+    }
+    decoder->setPresamples(presamples);
+    if (mKeepTrigNoise) {
+      decoder->setKeepTruNoise(mKeepTrigNoise);
+    }
+  }
+  LOG(info) << "Decoding with " << mNThreads << " thread(s)";
 }
 
 void RawToCellConverterSpec::run(framework::ProcessingContext& ctx)
@@ -127,57 +155,44 @@ void RawToCellConverterSpec::run(framework::ProcessingContext& ctx)
     mInitSimParams = false;
   }
 
+  // Decode the input messages (links) independently, each with the decoder and fitter of its thread.
+  // The bookkeeping of interaction records is then done sequentially in the original order of the pages,
+  // so that the output does not depend on the number of threads.
   std::vector<o2::framework::InputSpec> inputFilter{o2::framework::InputSpec{"filter", o2::framework::ConcreteDataTypeMatcher{"PHS", "RAWDATA"}, o2::framework::Lifetime::Timeframe}};
+  std::vector<gsl::span<const char>> rawmemories;
   for (const auto& rawData : framework::InputRecordWalker(ctx.inputs(), inputFilter)) {
-
     const gsl::span<const char>& rawmemory = o2::framework::DataRefUtils::as<const char>(rawData);
-    if (rawmemory.size() == 0) {
-      continue;
+    if (rawmemory.size() != 0) {
+      rawmemories.push_back(rawmemory);
     }
+  }
+  if (mDecodedLinks.size() < rawmemories.size()) {
+    mDecodedLinks.resize(rawmemories.size());
+  }
+  const auto tfOrbitFirst = ctx.services().get<o2::framework::TimingInfo>().firstTForbit;
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(mNThreads)
+#endif
+  for (int ilink = 0; ilink < int(rawmemories.size()); ilink++) {
+#ifdef WITH_OPENMP
+    int ithread = omp_get_thread_num();
+#else
+    int ithread = 0;
+#endif
+    decodeLink(rawmemories[ilink], tfOrbitFirst, ithread, mDecodedLinks[ilink]);
+  }
 
-    o2::phos::RawReaderMemory rawreader(rawmemory);
-
-    // loop over all the DMA pages
-    while (rawreader.hasNext()) {
-      try {
-        rawreader.next();
-      } catch (RawDecodingError::ErrorType_t e) {
-        // LOG(error) << "Raw decoding error " << (int)e;
-        // add error list
-        mOutputHWErrors.emplace_back(14, (int)e, 1); // Put general errors to non-existing DDL14
-        // if problem in header, abandon this page
-        if (e == RawDecodingError::ErrorType_t::PAGE_NOTFOUND ||
-            e == RawDecodingError::ErrorType_t::HEADER_DECODING ||
-            e == RawDecodingError::ErrorType_t::HEADER_INVALID) {
-          break;
-        }
-        // if problem in payload, try to continue
-        continue;
-      }
-      auto& header = rawreader.getRawHeader();
-      auto triggerBC = o2::raw::RDHUtils::getTriggerBC(header);
-      auto triggerOrbit = o2::raw::RDHUtils::getTriggerOrbit(header);
-      auto ddl = o2::raw::RDHUtils::getFEEID(header);
-
-      if (ddl >= o2::phos::Mapping::NDDL) { // only 0..13 correct DDLs
-        LOG(error) << "DDL=" << ddl;
-        mOutputHWErrors.emplace_back(14, 16, char(ddl)); // Add non-existing DDL as DDL 15
-        continue;                                        // skip STU ddl
-      }
-
-      o2::InteractionRecord currentIR(triggerBC, triggerOrbit);
-      // Correct for L0-LM trigger lattency
-      const auto tfOrbitFirst = ctx.services().get<o2::framework::TimingInfo>().firstTForbit;
-      const auto& ctpOffsets = o2::ctp::TriggerOffsetsParam::Instance();
-      if (currentIR.differenceInBC({0, tfOrbitFirst}) >= ctpOffsets.LM_L0) {
-        currentIR -= ctpOffsets.LM_L0; // guaranteed to stay in the TF containing the collision
-      } else {                         // discard the data associated with this IR as they came from previous TF
-        continue;
-      }
-
+  for (size_t ilink = 0; ilink < rawmemories.size(); ilink++) {
+    const auto& link = mDecodedLinks[ilink];
+    mOutputHWErrors.insert(mOutputHWErrors.end(), link.errs.begin(), link.errs.end());
+    if (mFillChi2) {
+      mOutputFitChi.insert(mOutputFitChi.end(), link.chi2.begin(), link.chi2.end());
+    }
+    for (const auto& page : link.pages) {
+      auto ddl = page.ddl;
       auto irIter = irList.rbegin();
       auto rangeIter = cellTRURanges.rbegin();
-      while (irIter != irList.rend() && *irIter != currentIR) {
+      while (irIter != irList.rend() && *irIter != page.ir) {
         irIter++;
         rangeIter++;
       }
@@ -185,37 +200,19 @@ void RawToCellConverterSpec::run(framework::ProcessingContext& ctx)
         (*rangeIter)[2 * ddl] = mTmpCells[ddl].size();    // start of the cell list
         (*rangeIter)[28 + 2 * ddl] = mTmpTRU[ddl].size(); // start of the tru list
       } else {                                            // create new entry
-        irList.push_back(currentIR);
+        irList.push_back(page.ir);
         cellTRURanges.emplace_back();
         cellTRURanges.back().fill(0);
         cellTRURanges.back()[2 * ddl] = mTmpCells[ddl].size();
         cellTRURanges.back()[28 + 2 * ddl] = mTmpTRU[ddl].size();
         rangeIter = cellTRURanges.rbegin();
       }
-      std::vector<Cell>& currentCellContainer = mTmpCells[ddl];
-      std::vector<Cell>& currentTRUContainer = mTmpTRU[ddl];
-
-      // use the altro decoder to decode the raw data, and extract the RCU trailer
-      mDecoder->decode(rawreader, mRawFitter.get(), currentCellContainer, currentTRUContainer);
-      const std::vector<o2::phos::RawReaderError>& errs = mDecoder->hwerrors();
-      for (auto a : errs) {
-        mOutputHWErrors.emplace_back(a);
-      }
-      if (mFillChi2) {
-        const std::vector<short>& chi2list = mDecoder->chi2list();
-        for (auto a : chi2list) {
-          mOutputFitChi.emplace_back(a);
-        }
-      }
-
-      // Sort cells according to cell ID
-      (*rangeIter)[2 * ddl + 1] = currentCellContainer.size();
-      auto itBegin = currentCellContainer.begin() + (*rangeIter)[2 * ddl];
-      std::sort(itBegin, currentCellContainer.end(), [](o2::phos::Cell& lhs, o2::phos::Cell& rhs) { return lhs.getAbsId() < rhs.getAbsId(); });
-      auto itTrBegin = currentTRUContainer.begin() + (*rangeIter)[28 + 2 * ddl];
-      (*rangeIter)[28 + 2 * ddl + 1] = currentTRUContainer.size();
-      std::sort(itTrBegin, currentTRUContainer.end(), [](o2::phos::Cell& lhs, o2::phos::Cell& rhs) { return lhs.getTRUId() < rhs.getTRUId(); });
-    } // RawReader::hasNext
+      // cells of the page are already sorted by the decoding thread
+      mTmpCells[ddl].insert(mTmpCells[ddl].end(), link.cells.begin() + page.cellFirst, link.cells.begin() + page.cellLast);
+      mTmpTRU[ddl].insert(mTmpTRU[ddl].end(), link.tru.begin() + page.truFirst, link.tru.begin() + page.truLast);
+      (*rangeIter)[2 * ddl + 1] = mTmpCells[ddl].size();
+      (*rangeIter)[28 + 2 * ddl + 1] = mTmpTRU[ddl].size();
+    }
   }
 
   // Loop over BCs, sort cells with increasing cell ID and write to output containers
@@ -298,6 +295,74 @@ void RawToCellConverterSpec::run(framework::ProcessingContext& ctx)
   }
 }
 
+void RawToCellConverterSpec::decodeLink(gsl::span<const char> rawmemory, uint32_t tfOrbitFirst, int ithread, DecodedLink& output)
+{
+  output.clear();
+  auto& decoder = *mDecoders[ithread];
+  auto* fitter = mRawFitters[ithread].get();
+  const auto& ctpOffsets = o2::ctp::TriggerOffsetsParam::Instance();
+
+  o2::phos::RawReaderMemory rawreader(rawmemory);
+
+  // loop over all the DMA pages
+  while (rawreader.hasNext()) {
+    try {
+      rawreader.next();
+    } catch (RawDecodingError::ErrorType_t e) {
+      // LOG(error) << "Raw decoding error " << (int)e;
+      // add error list
+      output.errs.emplace_back(14, (int)e, 1); // Put general errors to non-existing DDL14
+      // if problem in header, abandon this page
+      if (e == RawDecodingError::ErrorType_t::PAGE_NOTFOUND ||
+          e == RawDecodingError::ErrorType_t::HEADER_DECODING ||
+          e == RawDecodingError::ErrorType_t::HEADER_INVALID) {
+        break;
+      }
+      // if problem in payload, try to continue
+      continue;
+    }
+    auto& header = rawreader.getRawHeader();
+    auto triggerBC = o2::raw::RDHUtils::getTriggerBC(header);
+    auto triggerOrbit = o2::raw::RDHUtils::getTriggerOrbit(header);
+    auto ddl = o2::raw::RDHUtils::getFEEID(header);
+
+    if (ddl >= o2::phos::Mapping::NDDL) { // only 0..13 correct DDLs
+      LOG(error) << "DDL=" << ddl;
+      output.errs.emplace_back(14, 16, char(ddl)); // Add non-existing DDL as DDL 15
+      continue;                                    // skip STU ddl
+    }
+
+    o2::InteractionRecord currentIR(triggerBC, triggerOrbit);
+    // Correct for L0-LM trigger lattency
+    if (currentIR.differenceInBC({0, tfOrbitFirst}) >= ctpOffsets.LM_L0) {
+      currentIR -= ctpOffsets.LM_L0; // guaranteed to stay in the TF containing the collision
+    } else {                         // discard the data associated with this IR as they came from previous TF
+      continue;
+    }
+
+    auto& page = output.pages.emplace_back();
+    page.ir = currentIR;
+    page.ddl = ddl;
+    page.cellFirst = output.cells.size();
+    page.truFirst = output.tru.size();
+
+    // use the altro decoder to decode the raw data, and extract the RCU trailer
+    decoder.decode(rawreader, fitter, output.cells, output.tru);
+    const std::vector<o2::phos::RawReaderError>& errs = decoder.hwerrors();
+    output.errs.insert(output.errs.end(), errs.begin(), errs.end());
+    if (mFillChi2) {
+      const std::vector<short>& chi2list = decoder.chi2list();
+      output.chi2.insert(output.chi2.end(), chi2list.begin(), chi2list.end());
+    }
+
+    // Sort cells according to cell ID
+    page.cellLast = output.cells.size();
+    std::sort(output.cells.begin() + page.cellFirst, output.cells.end(), [](o2::phos::Cell& lhs, o2::phos::Cell& rhs) { return lhs.getAbsId() < rhs.getAbsId(); });
+    page.truLast = output.tru.size();
+    std::sort(output.tru.begin() + page.truFirst, output.tru.end(), [](o2::phos::Cell& lhs, o2::phos::Cell& rhs) { return lhs.getTRUId() < rhs.getTRUId(); });
+  }
+}
+
 o2::framework::DataProcessorSpec o2::phos::reco_workflow::getRawToCellConverterSpec(unsigned int flpId)
 {
   std::vector<o2::framework::InputSpec> inputs;
@@ -323,5 +388,6 @@ o2::framework::DataProcessorSpec o2::phos::reco_workflow::getRawToCellConverterS
                                             {"fillchi2", o2::framework::VariantType::String, "off", {"Fill sample qualities on/off"}},
                                             {"keepHGLG", o2::framework::VariantType::String, "off", {"keep HighGain and Low Gain signals on/off"}},
                                             {"pedestal", o2::framework::VariantType::String, "off", {"Analyze as pedestal run on/off"}},
-                                            {"keeptrig", o2::framework::VariantType::String, "off", {"Keep all trig. tiles for noise scan on/off"}}}};
+                                            {"keeptrig", o2::framework::VariantType::String, "off", {"Keep all trig. tiles for noise scan on/off"}},
+                                            {"nthreads", o2::framework::VariantType::Int, 1, {"Number of threads decoding the links in parallel"}}}};
 }
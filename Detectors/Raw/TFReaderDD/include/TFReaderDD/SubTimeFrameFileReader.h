@@ -52,6 +52,9 @@ class SubTimeFrameFileReader
   /// Read a single TF from the file
   std::unique_ptr<MessagesPerRoute> read(fair::mq::Device* device, const std::vector<o2f::OutputRoute>& outputRoutes, const std::string& rawChannel, size_t slice, bool sup0xccdb, int verbosity);
 
+  /// Get the positions of the TFs in the file, w/o reading their data
+  std::vector<std::uint64_t> getTFPositions();
+
   /// Tell the current position of the file
   inline std::uint64_t position() const { return mFileMapOffset; }
 
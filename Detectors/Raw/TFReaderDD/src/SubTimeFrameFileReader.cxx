@@ -178,6 +178,34 @@ Stack SubTimeFrameFileReader::getHeaderStack(std::size_t& pOrigsize)
   return Stack(lStackMem);
 }
 
+std::vector<std::uint64_t> SubTimeFrameFileReader::getTFPositions()
+{
+  // scan the TF meta headers to find the TF boundaries w/o reading the data, the current position is preserved
+  std::vector<std::uint64_t> positions;
+  const auto lStartPosition = position();
+  while (mFileMap.is_open() && !eof()) {
+    const auto lTfStartPosition = position();
+    std::size_t lMetaHdrStackSize = 0;
+    auto lMetaHdrStack = getHeaderStack(lMetaHdrStackSize);
+    SubTimeFrameFileMeta lStfFileMeta;
+    if (lMetaHdrStackSize == 0 || !read_advance(&lStfFileMeta, sizeof(SubTimeFrameFileMeta))) {
+      break;
+    }
+    const DataHeader* lStfMetaDataHdr = o2::header::DataHeader::Get(lMetaHdrStack.first());
+    if (!lStfMetaDataHdr || !(SubTimeFrameFileMeta::getDataHeader().dataDescription == lStfMetaDataHdr->dataDescription) ||
+        lStfFileMeta.mStfSizeInFile <= (sizeof(DataHeader) + sizeof(SubTimeFrameFileMeta)) || // empty TF stops the reading
+        (lTfStartPosition + lStfFileMeta.mStfSizeInFile) > size()) {
+      break;
+    }
+    positions.push_back(lTfStartPosition);
+    set_position(lTfStartPosition + lStfFileMeta.mStfSizeInFile);
+  }
+  if (mFileMap.is_open()) {
+    set_position(lStartPosition);
+  }
+  return positions;
+}
+
 std::uint32_t sRunNumber = 0;                     // TODO: add id to files metadata
 std::uint32_t sFirstTForbit = 0;                  // TODO: add id to files metadata
 std::uint64_t sCreationTime = 0;
@@ -227,9 +255,14 @@ std::unique_ptr<MessagesPerRoute> SubTimeFrameFileReader::read(fair::mq::Device*
     return nullptr;
   }
   auto tfID = slice;
-  uint32_t runNumberFallBack = sRunNumber;
-  uint32_t firstTForbitFallBack = sFirstTForbit;
-  uint64_t creationFallBack = sCreationTime;
+  uint32_t runNumberFallBack = 0, firstTForbitFallBack = 0;
+  uint64_t creationFallBack = 0;
+  {
+    std::lock_guard<std::mutex> lock(stfMtx); // several files may be read in parallel
+    runNumberFallBack = sRunNumber;
+    firstTForbitFallBack = sFirstTForbit;
+    creationFallBack = sCreationTime;
+  }
   bool negativeOrbitNotified = false, noRunNumberNotified = false, creation0Notified = false;
   std::size_t lMetaHdrStackSize = 0;
   const DataHeader* lStfMetaDataHdr = nullptr;
@@ -262,6 +295,7 @@ std::unique_ptr<MessagesPerRoute> SubTimeFrameFileReader::read(fair::mq::Device*
     }
     lStfFileMeta.mWriteTimeMs = creationFallBack;
   } else {
+    std::lock_guard<std::mutex> lock(stfMtx);
     sCreationTime = lStfFileMeta.mWriteTimeMs;
   }
 
@@ -43,6 +43,8 @@
 #include <deque>
 #include <chrono>
 #include <thread>
+#include <mutex>
+#include <condition_variable>
 
 using namespace o2::rawdd;
 using namespace std::chrono_literals;
@@ -68,6 +70,7 @@ class TFReaderSpec : public o2f::Task
  private:
   void stopProcessing(o2f::ProcessingContext& ctx);
   void TFBuilder();
+  void readFileParallel(const std::string& tfFileName, std::chrono::microseconds sleepTime);
 
  private:
   fair::mq::Device* mDevice = nullptr;
@@ -386,10 +389,11 @@ void TFReaderSpec::TFBuilder()
     }
 
     LOG(info) << "Processing file " << tfFileName;
-    SubTimeFrameFileReader reader(tfFileName, mInput.detMask);
-    size_t locID = 0;
-    // try
-    {
+    if (mInput.nReaderThreads > 1) {
+      readFileParallel(tfFileName, sleepTime);
+    } else {
+      SubTimeFrameFileReader reader(tfFileName, mInput.detMask);
+      size_t locID = 0;
       while (mRunning && mTFBuilderCounter < mInput.maxTFs) {
         if (mTFQueue.size() >= size_t(mInput.maxTFCache)) {
           if (mTFQueue.size() > 1) {
@@ -427,11 +431,130 @@ void TFReaderSpec::TFBuilder()
           break;
         }
       }
-      // remove already processed file from the queue, unless they are needed for further looping
-      if (mFileFetcher) {
-        mFileFetcher->popFromQueue(mFileFetcher->getNLoops() >= mInput.maxLoops);
+    }
+    // remove already processed file from the queue, unless they are needed for further looping
+    if (mFileFetcher) {
+      mFileFetcher->popFromQueue(mFileFetcher->getNLoops() >= mInput.maxLoops);
+    }
+  }
+}
+
+//____________________________________________________________
+void TFReaderSpec::readFileParallel(const std::string& tfFileName, std::chrono::microseconds sleepTime)
+{
+  // TFs of the file are read by mInput.nReaderThreads threads, each with its own mapping of the file, ahead of the
+  // DPL thread consumption. They are queued in the order of the file, with the same TF counting and selection as
+  // in the sequential mode. At most maxTFCache + nReaderThreads TFs are kept in flight beyond the queue.
+  struct TFTask {
+    std::uint64_t position = 0;
+    size_t slice = 0;
+    bool accept = true;
+    bool done = false;
+    std::unique_ptr<TFMap> tf;
+  };
+  std::vector<TFTask> tasks;
+  {
+    SubTimeFrameFileReader reader(tfFileName, mInput.detMask);
+    auto positions = reader.getTFPositions();
+    size_t selIDEntry = mSelIDEntry;
+    for (size_t i = 0; i < positions.size() && mTFBuilderCounter + int(i) < mInput.maxTFs; i++) {
+      auto& task = tasks.emplace_back();
+      task.position = positions[i];
+      task.slice = selIDEntry;
+      if (!mInput.tfIDs.empty()) {
+        task.accept = selIDEntry < mInput.tfIDs.size() && mInput.tfIDs[selIDEntry] == mTFBuilderCounter + int(i);
+      }
+      if (task.accept) {
+        selIDEntry++;
+      } else {
+        task.done = true; // discarded TFs are not read at all
+      }
+    }
+  }
+  LOGP(info, "Will read {} TFs from {} with {} threads", tasks.size(), tfFileName, mInput.nReaderThreads);
+
+  std::mutex mtx;
+  std::condition_variable cv;
+  size_t nextTask = 0, nextToQueue = 0;
+  bool abandon = false;
+  const size_t window = mInput.maxTFCache + mInput.nReaderThreads;
+  auto worker = [&]() {
+    SubTimeFrameFileReader reader(tfFileName, mInput.detMask);
+    std::unique_lock<std::mutex> lock(mtx);
+    while (true) {
+      while (!cv.wait_for(lock, sleepTime, [&] { return !mRunning || abandon || nextTask >= tasks.size() || nextTask < nextToQueue + window; })) {
+      }
+      if (!mRunning || abandon || nextTask >= tasks.size()) {
+        return;
+      }
+      auto& task = tasks[nextTask++];
+      if (!task.accept) {
+        continue;
+      }
+      lock.unlock();
+      std::unique_ptr<TFMap> tf;
+      if (task.position < reader.size()) { // the reader is reset if the file was found to be corrupted
+        reader.set_position(task.position);
+        tf = reader.read(mDevice, mOutputRoutes, mInput.rawChannelConfig, task.slice, mInput.sup0xccdb, mInput.verbosity);
       }
+      lock.lock();
+      task.tf = std::move(tf);
+      task.done = true;
+      cv.notify_all();
     }
+  };
+  std::vector<std::thread> workers;
+  for (int i = 0; i < mInput.nReaderThreads; i++) {
+    workers.emplace_back(worker);
+  }
+
+  for (size_t it = 0; it < tasks.size() && mRunning; it++) {
+    std::unique_ptr<TFMap> tf;
+    {
+      std::unique_lock<std::mutex> lock(mtx);
+      while (!cv.wait_for(lock, sleepTime, [&] { return !mRunning || tasks[it].done; })) { // mRunning may be reset w/o notification
+      }
+      tf = std::move(tasks[it].tf);
+    }
+    if (!mRunning) {
+      break;
+    }
+    if (!tasks[it].accept) {
+      LOGP(info, "Retrieved TF#{} will be discared following user request", mTFBuilderCounter);
+    } else if (!tf) { // failed to read, the rest of the file is dropped as in the sequential mode
+      break;
+    } else {
+      if (!mInput.tfIDs.empty()) {
+        mWaitSendingLast = false;
+        LOGP(info, "Retrieved TF#{} will be pushed as slice {} following user request", mTFBuilderCounter, mSelIDEntry);
+      }
+      mSelIDEntry++;
+      while (mRunning && mTFQueue.size() >= size_t(mInput.maxTFCache)) {
+        if (mTFQueue.size() > 1) {
+          mWaitSendingLast = false;
+        }
+        std::this_thread::sleep_for(sleepTime);
+      }
+      if (!mRunning) {
+        break;
+      }
+      mWaitSendingLast = true;
+      mTFQueue.push(std::move(tf));
+    }
+    mTFBuilderCounter++;
+    {
+      std::lock_guard<std::mutex> lock(mtx);
+      nextToQueue = it + 1;
+    }
+    cv.notify_all();
+  }
+  {
+    std::lock_guard<std::mutex> lock(mtx);
+    abandon = true;
+  }
+  cv.notify_all();
+  for (auto& w : workers) {
+    w.join();
   }
 }
 
@@ -39,6 +39,7 @@ struct TFReaderInp {
   int tfRateLimit = -999;
   int maxTFCache = 1;
   int maxFileCache = 1;
+  int nReaderThreads = 1;
   int verbosity = 0;
   int64_t delay_us = 0;
   int maxLoops = 0;
@@ -54,6 +54,7 @@ struct ReaderInp {
   uint32_t maxTF = 0xffffffff;
   bool partPerSP = true;
   bool cache = false;
+  bool mapFiles = false;
   bool autodetectTF0 = false;
   bool preferCalcTF = false;
   bool sup0xccdb = false;
@@ -209,6 +210,7 @@ class RawFileReader
     size_t readNextHBF(char* buff);
     size_t readNextTF(char* buff);
     size_t readNextSuperPage(char* buff, const PartStat* pstat = nullptr);
+    const char* getNextSuperPagePtr(size_t& sz, const PartStat* pstat = nullptr);
     size_t skipNextHBF();
     size_t skipNextTF();
 
@@ -217,6 +219,7 @@ class RawFileReader
     std::string describe() const;
 
    private:
+    int getNextSuperPageEnd(size_t& sz, const PartStat* pstat) const;
     RawFileReader* reader = nullptr; //!
   };
 
@@ -272,6 +275,10 @@ class RawFileReader
   bool getCacheData() const { return mCacheData; }
   void setCacheData(bool v) { mCacheData = v; }
 
+  bool getMapFiles() const { return mMapFiles; }
+  void setMapFiles(bool v) { mMapFiles = v; }
+  const char* getMappedData(int fileID, size_t offset) const { return fileID < int(mMappedFiles.size()) && mMappedFiles[fileID].first ? mMappedFiles[fileID].first + offset : nullptr; }
+
   o2::header::DataOrigin getDefaultDataOrigin() const { return mDefDataOrigin; }
   o2::header::DataDescription getDefaultDataSpecification() const { return mDefDataDescription; }
   ReadoutCardType getDefaultReadoutCardType() const { return mDefCardType; }
@@ -292,17 +299,23 @@ class RawFileReader
  private:
   int getLinkLocalID(const RDHAny& rdh, int fileID);
   bool preprocessFile(int ifl);
+  bool mapFiles();
+  void unmapFiles();
+  bool readFromFile(int fileID, size_t offset, size_t size, char* buff) const;
   static LinkSpec_t createSpec(o2::header::DataOrigin orig, LinkSubSpec_t ss) { return (LinkSpec_t(orig) << 32) | ss; }
 
   static constexpr o2::header::DataOrigin DEFDataOrigin = o2::header::gDataOriginFLP;
   static constexpr o2::header::DataDescription DEFDataDescription = o2::header::gDataDescriptionRawData;
   static constexpr ReadoutCardType DEFCardType = CRU;
+  static constexpr size_t MappedReadAheadWindow = 64UL * 1024 * 1024; // granularity of read-ahead requests for mapped files
   o2::header::DataOrigin mDefDataOrigin = DEFDataOrigin;                //!
   o2::header::DataDescription mDefDataDescription = DEFDataDescription; //!
   ReadoutCardType mDefCardType = CRU;                                   //!
   std::vector<std::string> mFileNames;                                  //! input file names
   std::vector<FILE*> mFiles;                                            //! input file handlers
   std::vector<std::unique_ptr<char[]>> mFileBuffers;                    //! buffers for input files
+  std::vector<std::pair<const char*, size_t>> mMappedFiles;             //! memory-mapped input files (if mMapFiles)
+  mutable std::vector<std::vector<bool>> mReadAheadWindows;             //! windows of the mapped files for which the read-ahead was requested
   std::vector<OrigDescCard> mDataSpecs;                                 //! data origin and description for every input file + readout card type
   bool mInitDone = false;
   bool mEmpty = true;
@@ -320,6 +333,7 @@ class RawFileReader
   long int mPosInFile = 0;                                          //! current position in the file
   bool mMultiLinkFile = false;                                      //! was > than 1 link seen in the file?
   bool mCacheData = false;                                          //! cache data to block after 1st scan (may require excessive memory, use with care)
+  bool mMapFiles = false;                                           //! mmap input files instead of reading them via stdio
   bool mStopProcessing = false;                                     //! stop processing after error
   uint32_t mCheckErrors = 0;                                        //! mask for errors to check
   FirstTFDetection mFirstTFAutodetect = FirstTFDetection::Disabled; //!
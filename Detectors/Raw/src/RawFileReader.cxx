@@ -30,6 +30,9 @@
 #include <Common/Configuration.h>
 #include <TStopwatch.h>
 #include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <cerrno>
 
 using namespace o2::raw;
 namespace o2h = o2::header;
@@ -134,8 +137,7 @@ size_t RawFileReader::LinkData::readNextHBF(char* buff)
     if (blc.dataCache) {
       memcpy(buff + sz, blc.dataCache.get(), blc.size);
     } else {
-      auto fl = reader->mFiles[blc.fileID];
-      if (fseek(fl, blc.offset, SEEK_SET) || fread(buff + sz, 1, blc.size, fl) != blc.size) {
+      if (!reader->readFromFile(blc.fileID, blc.offset, blc.size, buff + sz)) {
         LOGF(error, "Failed to read for the %s a bloc:", describe());
         blc.print();
         error = true;
@@ -265,9 +267,50 @@ size_t RawFileReader::LinkData::readNextSuperPage(char* buff, const RawFileReade
   if (nextBlock2Read < 0) { // negative nextBlock2Read signals absence of data
     return sz;
   }
-  int ibl = nextBlock2Read, nbl = blocks.size();
-  auto tfID = blocks[nextBlock2Read].tfID;
   bool error = false;
+  int ibl = getNextSuperPageEnd(sz, pstat);
+  if (sz) {
+    if (reader->mCacheData && blocks[nextBlock2Read].dataCache) {
+      memcpy(buff, blocks[nextBlock2Read].dataCache.get(), sz);
+    } else {
+      if (!reader->readFromFile(blocks[nextBlock2Read].fileID, blocks[nextBlock2Read].offset, sz, buff)) {
+        LOGF(error, "Failed to read for the %s a bloc:", describe());
+        blocks[nextBlock2Read].print();
+        error = true;
+      } else if (reader->mCacheData) { // cache after 1st reading
+        blocks[nextBlock2Read].dataCache = std::make_unique<char[]>(sz);
+        memcpy(blocks[nextBlock2Read].dataCache.get(), buff, sz);
+      }
+    }
+  }
+  nextBlock2Read = ibl;
+  return error ? 0 : sz; // in case of the error we ignore the data
+}
+
+//____________________________________________
+const char* RawFileReader::LinkData::getNextSuperPagePtr(size_t& sz, const RawFileReader::PartStat* pstat)
+{
+  // zero-copy access to the data of the next superpage in the memory-mapped file, nullptr is returned
+  // if the files are not mapped (in which case nothing is consumed and readNextSuperPage should be used)
+  sz = 0;
+  if (nextBlock2Read < 0) { // negative nextBlock2Read signals absence of data
+    return nullptr;
+  }
+  const auto& blc = blocks[nextBlock2Read];
+  const char* ptr = reader->getMappedData(blc.fileID, blc.offset);
+  if (!ptr) {
+    return nullptr;
+  }
+  nextBlock2Read = getNextSuperPageEnd(sz, pstat); // blocks of the superpage are contiguous in the file
+  return ptr;
+}
+
+//____________________________________________
+int RawFileReader::LinkData::getNextSuperPageEnd(size_t& sz, const RawFileReader::PartStat* pstat) const
+{
+  // find the block following the superpage starting at nextBlock2Read, fill its size
+  int ibl = nextBlock2Read, nbl = blocks.size();
+  sz = 0;
   if (pstat) { // info is provided, use it derictly
     sz = pstat->size;
     ibl += pstat->nBlocks;
@@ -284,23 +327,7 @@ size_t RawFileReader::LinkData::readNextSuperPage(char* buff, const RawFileReade
       sz += blc.size;
     }
   }
-  if (sz) {
-    if (reader->mCacheData && blocks[nextBlock2Read].dataCache) {
-      memcpy(buff, blocks[nextBlock2Read].dataCache.get(), sz);
-    } else {
-      auto fl = reader->mFiles[blocks[nextBlock2Read].fileID];
-      if (fseek(fl, blocks[nextBlock2Read].offset, SEEK_SET) || fread(buff, 1, sz, fl) != sz) {
-        LOGF(error, "Failed to read for the %s a bloc:", describe());
-        blocks[nextBlock2Read].print();
-        error = true;
-      } else if (reader->mCacheData) { // cache after 1st reading
-        blocks[nextBlock2Read].dataCache = std::make_unique<char[]>(sz);
-        memcpy(blocks[nextBlock2Read].dataCache.get(), buff, sz);
-      }
-    }
-  }
-  nextBlock2Read = ibl;
-  return error ? 0 : sz; // in case of the error we ignore the data
+  return ibl;
 }
 
 //____________________________________________
@@ -573,7 +600,8 @@ int RawFileReader::getLinkLocalID(const RDHAny& rdh, int fileID)
 bool RawFileReader::preprocessFile(int ifl)
 {
   // preprocess file, check RDH data, build statistics
-  std::unique_ptr<char[]> buffer = std::make_unique<char[]>(mBufferSize);
+  const char* mapped = getMappedData(ifl, 0); // if the file is mapped, scan it in place
+  std::unique_ptr<char[]> buffer = mapped ? nullptr : std::make_unique<char[]>(mBufferSize);
   FILE* fl = mFiles[ifl];
   mCurrentFileID = ifl;
   LinkSpec_t specPrev = 0xffffffffffffffff;
@@ -586,10 +614,11 @@ bool RawFileReader::preprocessFile(int ifl)
   mPosInFile = 0;
   size_t nRDHread = 0, boffs;
   bool readMore = true;
-  while (readMore && (nr = fread(buffer.get(), 1, mBufferSize, fl))) {
+  while (readMore && (nr = mapped ? fileSize : fread(buffer.get(), 1, mBufferSize, fl))) {
+    const char* buff = mapped ? mapped : buffer.get();
     boffs = 0;
     while (1) {
-      auto& rdh = *reinterpret_cast<RDHUtils::RDHAny*>(&buffer[boffs]);
+      auto& rdh = *reinterpret_cast<const RDHUtils::RDHAny*>(&buff[boffs]);
       if ((mPosInFile + RDHUtils::getOffsetToNext(rdh)) > fileSize) {
         LOGP(warning, "File {} truncated current file pos {} + offsetToNext {} > fileSize {}", ifl, mPosInFile, RDHUtils::getOffsetToNext(rdh), fileSize);
         readMore = false;
@@ -630,6 +659,13 @@ bool RawFileReader::preprocessFile(int ifl)
       boffs += RDHUtils::getOffsetToNext(rdh);
       mPosInFile += RDHUtils::getOffsetToNext(rdh);
       lIDPrev = lID;
+      if (mapped) { // mapped file is scanned in one go, till there is no room left for an RDH
+        if (boffs + sizeof(RDHUtils::RDHAny) > nr) {
+          readMore = false;
+          break;
+        }
+        continue;
+      }
       if (boffs + sizeof(RDHUtils::RDHAny) >= nr) {
         if (fseek(fl, mPosInFile, SEEK_SET)) {
           readMore = false;
@@ -662,6 +698,7 @@ void RawFileReader::clear()
   mLinkEntries.clear();
   mOrderedIDs.clear();
   mLinksData.clear();
+  unmapFiles();
   for (auto fl : mFiles) {
     fclose(fl);
   }
@@ -708,6 +745,73 @@ bool RawFileReader::addFile(const std::string& sname, o2::header::DataOrigin ori
   return true;
 }
 
+//_____________________________________________________________________
+bool RawFileReader::mapFiles()
+{
+  // map all input files to memory, the data will be scanned and served directly from the page cache
+  if (mCacheData) {
+    LOG(warning) << "Data caching is redundant for memory-mapped input, disabling it";
+    mCacheData = false;
+  }
+  unmapFiles();
+  for (int i = 0; i < int(mFiles.size()); i++) {
+    int fd = fileno(mFiles[i]);
+    struct stat st;
+    if (fstat(fd, &st) || st.st_size <= 0) {
+      LOG(error) << "Failed to get the size of " << mFileNames[i] << " for mapping";
+      unmapFiles();
+      return false;
+    }
+    void* ptr = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (ptr == MAP_FAILED) {
+      LOGP(error, "Failed to map {} of {} bytes: {}", mFileNames[i], st.st_size, strerror(errno));
+      unmapFiles();
+      return false;
+    }
+    madvise(ptr, st.st_size, MADV_SEQUENTIAL); // preprocessing will scan the file linearly
+    mMappedFiles.emplace_back(reinterpret_cast<const char*>(ptr), st.st_size);
+    mReadAheadWindows.emplace_back((st.st_size + MappedReadAheadWindow - 1) / MappedReadAheadWindow, false);
+  }
+  return true;
+}
+
+//_____________________________________________________________________
+void RawFileReader::unmapFiles()
+{
+  for (auto& mf : mMappedFiles) {
+    if (mf.first) {
+      munmap(const_cast<char*>(mf.first), mf.second);
+    }
+  }
+  mMappedFiles.clear();
+  mReadAheadWindows.clear();
+}
+
+//_____________________________________________________________________
+bool RawFileReader::readFromFile(int fileID, size_t offset, size_t size, char* buff) const
+{
+  // read size bytes at offset of the file, from the mapping if available
+  if (const char* src = getMappedData(fileID, offset)) {
+    const auto& mf = mMappedFiles[fileID];
+    if (offset + size > mf.second) {
+      return false;
+    }
+    memcpy(buff, src, size);
+    // links are read interleaved, ask the kernel to bring in the window following this chunk,
+    // once per window rather than for every block
+    auto& windows = mReadAheadWindows[fileID];
+    size_t next = (offset + size) / MappedReadAheadWindow;
+    if (next < windows.size() && !windows[next]) {
+      windows[next] = true;
+      size_t ahead = next * MappedReadAheadWindow;
+      madvise(const_cast<char*>(mf.first) + ahead, std::min(MappedReadAheadWindow, mf.second - ahead), MADV_WILLNEED);
+    }
+    return true;
+  }
+  auto fl = mFiles[fileID];
+  return !fseek(fl, offset, SEEK_SET) && fread(buff, 1, size, fl) == size;
+}
+
 //_____________________________________________________________________
 bool RawFileReader::init()
 {
@@ -722,6 +826,9 @@ bool RawFileReader::init()
     LOGF(info, "at most %u TF will be processed", mMaxTFToRead);
   }
 
+  if (mMapFiles && !mapFiles()) {
+    return false;
+  }
   int nf = mFiles.size();
   mEmpty = true;
   for (int i = 0; i < nf; i++) {
@@ -729,6 +836,9 @@ bool RawFileReader::init()
       mEmpty = false;
     }
   }
+  for (auto& mf : mMappedFiles) { // data of different links will be read interleaved
+    madvise(const_cast<char*>(mf.first), mf.second, MADV_NORMAL);
+  }
   if (mStopProcessing) {
     LOG(error) << "Abandoning processing due to corrupted data";
     return false;
@@ -102,6 +102,7 @@ RawReaderSpecs::RawReaderSpecs(const ReaderInp& rinp)
   mReader->setMaxTFToRead(rinp.maxTF);
   mReader->setNominalSPageSize(rinp.spSize);
   mReader->setCacheData(rinp.cache);
+  mReader->setMapFiles(rinp.mapFiles);
   mReader->setTFAutodetect(rinp.autodetectTF0 ? RawFileReader::FirstTFDetection::Pending : RawFileReader::FirstTFDetection::Disabled);
   mReader->setPreferCalculatedTFStart(rinp.preferCalcTF);
   LOG(info) << "Will preprocess files with buffer size of " << rinp.bufferSize << " bytes";
@@ -263,11 +264,20 @@ void RawReaderSpecs::run(o2f::ProcessingContext& ctx)
     }
 
     auto fmqFactory = device->GetChannel(fmqChannel, 0).Transport();
+    // superpages of mapped files can be sent without copy unless the transport copies external buffers anyway (shmem)
+    bool zeroCopy = mPartPerSP && mReader->getMapFiles() && fmqFactory->GetType() != fair::mq::Transport::SHM;
     while (hdrTmpl.splitPayloadIndex < hdrTmpl.splitPayloadParts) {
       hdrTmpl.payloadSize = mPartPerSP ? partsSP[hdrTmpl.splitPayloadIndex].size : link.getNextHBFSize();
       auto hdMessage = fmqFactory->CreateMessage(hstackSize, fair::mq::Alignment{64});
-      auto plMessage = fmqFactory->CreateMessage(hdrTmpl.payloadSize, fair::mq::Alignment{64});
-      auto bread = mPartPerSP ? link.readNextSuperPage(reinterpret_cast<char*>(plMessage->GetData()), &partsSP[hdrTmpl.splitPayloadIndex]) : link.readNextHBF(reinterpret_cast<char*>(plMessage->GetData()));
+      fair::mq::MessagePtr plMessage;
+      size_t bread = 0;
+      const char* mappedSP = zeroCopy ? link.getNextSuperPagePtr(bread, &partsSP[hdrTmpl.splitPayloadIndex]) : nullptr;
+      if (mappedSP) { // the mapping stays valid as long as the reader, nothing to free
+        plMessage = fmqFactory->CreateMessage(const_cast<char*>(mappedSP), bread, [](void*, void*) {}, nullptr);
+      } else {
+        plMessage = fmqFactory->CreateMessage(hdrTmpl.payloadSize, fair::mq::Alignment{64});
+        bread = mPartPerSP ? link.readNextSuperPage(reinterpret_cast<char*>(plMessage->GetData()), &partsSP[hdrTmpl.splitPayloadIndex]) : link.readNextHBF(reinterpret_cast<char*>(plMessage->GetData()));
+      }
       if (bread != hdrTmpl.payloadSize) {
         LOG(error) << "Link " << il << " read " << bread << " bytes instead of " << hdrTmpl.payloadSize
                    << " expected in TF=" << mTFCounter << " part=" << hdrTmpl.splitPayloadIndex;
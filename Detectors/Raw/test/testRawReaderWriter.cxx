@@ -330,3 +330,33 @@ BOOST_AUTO_TEST_CASE(RawReaderWriter_RORC)
 }
 
 } // namespace o2
+
+BOOST_AUTO_TEST_CASE(RawReaderWriter_MappedScan)
+{
+  // every CRU link file ends with an empty closing page, i.e. with a bare 64-byte RDH, which must be indexed by the mapped scan as well
+  TestRawWriter dw{"TST", true, "test_raw_conf_map.cfg"};
+  dw.init();
+  dw.run();
+  //
+  RawFileReader readerF("test_raw_conf_map.cfg"), readerM("test_raw_conf_map.cfg");
+  readerM.setMapFiles(true);
+  readerF.init();
+  readerM.init();
+  BOOST_CHECK(readerM.getNLinks() == readerF.getNLinks());
+  BOOST_CHECK(readerM.getNTimeFrames() == readerF.getNTimeFrames());
+  for (int il = 0; il < readerF.getNLinks(); il++) {
+    const auto &lnkF = readerF.getLink(il), &lnkM = readerM.getLink(il);
+    BOOST_CHECK(lnkM.nErrors == lnkF.nErrors);
+    BOOST_CHECK(lnkM.nTimeFrames == lnkF.nTimeFrames);
+    BOOST_CHECK(lnkM.nHBFrames == lnkF.nHBFrames);
+    BOOST_REQUIRE(lnkM.blocks.size() == lnkF.blocks.size());
+    for (size_t ib = 0; ib < lnkF.blocks.size(); ib++) {
+      const auto &blF = lnkF.blocks[ib], &blM = lnkM.blocks[ib];
+      BOOST_CHECK(blM.fileID == blF.fileID);
+      BOOST_CHECK(blM.offset == blF.offset);
+      BOOST_CHECK(blM.size == blF.size);
+      BOOST_CHECK(blM.tfID == blF.tfID);
+      BOOST_CHECK(blM.flags == blF.flags);
+    }
+  }
+}
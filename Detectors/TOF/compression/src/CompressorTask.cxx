@@ -15,6 +15,7 @@
 /// @brief  TOF raw data compressor task
 
 #include "TOFCompression/CompressorTask.h"
+#include <algorithm>
 #include "Framework/ControlService.h"
 #include "Framework/ConfigParamRegistry.h"
 #include "Framework/DeviceSpec.h"
@@ -22,6 +23,10 @@
 #include "Framework/InputRecordWalker.h"
 #include "CommonUtils/VerbosityConfig.h"
 
+#ifdef WITH_OPENMP
+#include <omp.h>
+#endif
+
 using namespace o2::framework;
 
 namespace o2::tof
@@ -41,14 +46,30 @@ void CompressorTask<RDH, verbose, paranoid>::init(InitContext& ic)
   auto encoderVerbose = ic.options().get<bool>("tof-compressor-encoder-verbose");
   auto checkerVerbose = ic.options().get<bool>("tof-compressor-checker-verbose");
   mOutputBufferSize = ic.options().get<int>("tof-compressor-output-buffer-size");
-
-  mCompressor.setDecoderCONET(decoderCONET);
-  mCompressor.setDecoderVerbose(decoderVerbose);
-  mCompressor.setEncoderVerbose(encoderVerbose);
-  mCompressor.setCheckerVerbose(checkerVerbose);
+  mNThreads = std::max(1, ic.options().get<int>("tof-compressor-threads"));
+#ifndef WITH_OPENMP
+  mNThreads = 1;
+#endif
+  if (mNThreads > 1 && (decoderVerbose || encoderVerbose || checkerVerbose)) {
+    LOG(info) << "Verbose mode requested, compressing with 1 thread";
+    mNThreads = 1;
+  }
+  LOG(info) << "Compressing with " << mNThreads << " thread(s)";
+
+  /** compressors keep decoder/encoder state, one per thread **/
+  mCompressors.clear();
+  for (int ith = 0; ith < mNThreads; ith++) {
+    auto& compressor = mCompressors.emplace_back(std::make_unique<Compressor<RDH, verbose, paranoid>>());
+    compressor->setDecoderCONET(decoderCONET);
+    compressor->setDecoderVerbose(decoderVerbose);
+    compressor->setEncoderVerbose(encoderVerbose);
+    compressor->setCheckerVerbose(checkerVerbose);
+  }
 
   auto finishFunction = [this]() {
-    mCompressor.checkSummary();
+    for (auto& compressor : mCompressors) {
+      compressor->checkSummary();
+    }
   };
 
   ic.services().get<CallbackService>().set<CallbackService::Id::Stop>(finishFunction);
@@ -111,11 +132,20 @@ void CompressorTask<RDH, verbose, paranoid>::run(ProcessingContext& pc)
     //  }
   }
 
-  /** loop over subspecs **/
+  /** prepare one output per subspec, the allocator is not thread safe **/
+  struct SubspecOutput {
+    const std::vector<o2::framework::DataRef>* parts;
+    o2::header::DataHeader headerOut;
+    Output output;
+    o2::pmr::vector<char> buffer;
+    long bufferSize;
+  };
+  std::vector<SubspecOutput> subspecOutputs;
+  subspecOutputs.reserve(subspecPartMap.size());
   for (auto& subspecPartEntry : subspecPartMap) {
 
     auto subspec = subspecPartEntry.first;
-    auto parts = subspecPartEntry.second;
+    auto& parts = subspecPartEntry.second;
     auto& firstPart = parts.at(0);
 
     /** use the first part to define output headers **/
@@ -130,13 +160,29 @@ void CompressorTask<RDH, verbose, paranoid>::run(ProcessingContext& pc)
     auto output = Output{headerOut.dataOrigin, "CRAWDATA", headerOut.subSpecification};
     auto&& v = pc.outputs().makeVector<char>(output);
     v.resize(bufferSizeDouble);
+    subspecOutputs.push_back({&parts, headerOut, output, std::move(v), bufferSize});
+  }
+
+  /** loop over subspecs, independent crates are compressed concurrently **/
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(mNThreads)
+#endif
+  for (int isubspec = 0; isubspec < int(subspecOutputs.size()); isubspec++) {
+#ifdef WITH_OPENMP
+    auto& compressor = *mCompressors[omp_get_thread_num()];
+#else
+    auto& compressor = *mCompressors[0];
+#endif
+    auto& subspecOutput = subspecOutputs[isubspec];
+    auto& headerOut = subspecOutput.headerOut;
+    auto bufferSize = subspecOutput.bufferSize;
     // Better way of doing this would be to used an offset, so that we can resize the vector
     // as well. However, this should be good enough because bufferSize overestimates the size
     // of the payload.
-    auto bufferPointer = v.data();
+    auto bufferPointer = subspecOutput.buffer.data();
 
     /** loop over subspec parts **/
-    for (const auto& ref : parts) {
+    for (const auto& ref : *subspecOutput.parts) {
       /** input **/
       auto payloadIn = ref.payload;
       auto payloadInSize = DataRefUtils::getPayloadSize(ref);
@@ -147,25 +193,28 @@ void CompressorTask<RDH, verbose, paranoid>::run(ProcessingContext& pc)
       }
 
       /** prepare compressor **/
-      mCompressor.setDecoderBuffer(payloadIn);
-      mCompressor.setDecoderBufferSize(payloadInSize);
-      mCompressor.setEncoderBuffer(bufferPointer);
-      mCompressor.setEncoderBufferSize(bufferSize);
+      compressor.setDecoderBuffer(payloadIn);
+      compressor.setDecoderBufferSize(payloadInSize);
+      compressor.setEncoderBuffer(bufferPointer);
+      compressor.setEncoderBufferSize(bufferSize);
 
       /** run **/
-      mCompressor.run();
-      auto payloadOutSize = mCompressor.getEncoderByteCounter();
+      compressor.run();
+      auto payloadOutSize = compressor.getEncoderByteCounter();
       bufferPointer += payloadOutSize;
       bufferSize -= payloadOutSize;
       headerOut.payloadSize += payloadOutSize;
     }
 
-    if (headerOut.payloadSize > bufferSizeDouble) {
+    if (headerOut.payloadSize > subspecOutput.buffer.size()) {
       headerOut.payloadSize = 0; // put payload to zero, otherwise it will trigger a crash
     }
+  }
 
-    v.resize(headerOut.payloadSize);
-    pc.outputs().adoptContainer(output, std::move(v));
+  /** send outputs in the subspec order **/
+  for (auto& subspecOutput : subspecOutputs) {
+    subspecOutput.buffer.resize(subspecOutput.headerOut.payloadSize);
+    pc.outputs().adoptContainer(subspecOutput.output, std::move(subspecOutput.buffer));
   }
 }
 
@@ -30,6 +30,7 @@
 #include <fairlogger/Logger.h>
 
 #include <vector>
+#include <algorithm>
 #include <iostream>
 #include <iomanip>
 
@@ -94,6 +95,41 @@ BOOST_AUTO_TEST_CASE(FastTransform_test1)
   BOOST_CHECK(fabs(maxDy) < 1.e-5);
 }
 
+/// @brief Test that the bulk transformation agrees with the point-by-point one
+BOOST_AUTO_TEST_CASE(FastTransform_test_bulk)
+{
+  std::unique_ptr<TPCFastTransform> fastTransform(TPCFastTransformHelperO2::instance()->create(0));
+  const TPCFastTransformGeo& geo = fastTransform->getGeometry();
+  fastTransform->setApplyCorrectionOn();
+
+  for (int slice = 0; slice < geo.getNumberOfSlices(); slice += 7) {
+    std::vector<int> rows;
+    std::vector<float> pads, times;
+    float lastTimeBin = fastTransform->getMaxDriftTime(slice);
+    for (int row = 0; row < geo.getNumberOfRows(); row++) {
+      int nPads = geo.getRowInfo(row).maxPad + 1;
+      for (int pad = 0; pad < nPads; pad += 7) {
+        for (float time = 0; time < lastTimeBin; time += 50.5f) {
+          rows.push_back(row);
+          pads.push_back(pad + 0.3f);
+          times.push_back(time);
+        }
+      }
+    }
+    int n = rows.size();
+    std::vector<float> x(n), y(n), z(n);
+    fastTransform->TransformBulk(slice, n, rows.data(), pads.data(), times.data(), x.data(), y.data(), z.data());
+
+    double maxDiff = 0.;
+    for (int i = 0; i < n; i++) {
+      float x0, y0, z0;
+      fastTransform->Transform(slice, rows[i], pads[i], times[i], x0, y0, z0);
+      maxDiff = std::max<double>({maxDiff, fabs(x0 - x[i]), fabs(y0 - y[i]), fabs(z0 - z[i])});
+    }
+    BOOST_CHECK_MESSAGE(maxDiff < 1.e-4, "bulk transformation differs by " << maxDiff << " cm in slice " << slice);
+  }
+}
+
 #ifdef XXX
 BOOST_AUTO_TEST_CASE(FastTransform_test_setSpaceChargeCorrection)
 {
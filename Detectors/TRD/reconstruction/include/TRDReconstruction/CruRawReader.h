@@ -22,6 +22,8 @@
 #include <set>
 #include <utility>
 #include <array>
+#include <atomic>
+#include <memory>
 #include "Headers/RAWDataHeader.h"
 #include "Headers/RDHAny.h"
 #include "DetectorsRaw/RDHUtils.h"
@@ -74,9 +76,11 @@ class CruRawReader
   // settings in order to avoid InfoLogger flooding
   void setMaxErrWarnPrinted(int nerr, int nwar)
   {
-    mMaxErrsPrinted = nerr < 0 ? std::numeric_limits<int>::max() : nerr;
-    mMaxWarnPrinted = nwar < 0 ? std::numeric_limits<int>::max() : nwar;
+    mPrintLimits->maxErrs = nerr < 0 ? std::numeric_limits<int>::max() : nerr;
+    mPrintLimits->maxWarn = nwar < 0 ? std::numeric_limits<int>::max() : nwar;
   }
+  // count the printed errors and warnings together with other, e.g. for readers parsing the same TF in parallel
+  void sharePrintLimits(const CruRawReader& other) { mPrintLimits = other.mPrintLimits; }
   void checkNoWarn(bool silently = true);
   void checkNoErr();
 
@@ -100,6 +104,10 @@ class CruRawReader
   // reset the event storage and the counters
   void reset();
 
+  // add the output and counters of another reader which processed a different part of the same TF,
+  // the data of the other reader is appended and its event storage and counters are reset
+  void merge(CruRawReader& other);
+
   // the parsing starts here, payload from all available RDHs is copied into mHBFPayload and afterwards processHalfCRU() is called
   // returns the total number of bytes read, including RDH header
   int processHBFs();
@@ -159,9 +167,12 @@ class CruRawReader
 
   std::array<uint32_t, constants::HBFBUFFERMAX> mHBFPayload; // the full input data payload excluding the RDH header(s)
 
-  // InfoLogger flood protection settings
-  int mMaxErrsPrinted = 20;
-  int mMaxWarnPrinted = 20;
+  // InfoLogger flood protection settings, possibly shared with other readers
+  struct PrintLimits {
+    std::atomic<int> maxErrs{20};
+    std::atomic<int> maxWarn{20};
+  };
+  std::shared_ptr<PrintLimits> mPrintLimits = std::make_shared<PrintLimits>();
 
   // helper pointers, counters for the input buffer
   const char* mDataBufferPtr = nullptr; // pointer to the beginning of the whole payload data
@@ -24,6 +24,8 @@
 #include "DataFormatsTRD/Digit.h"
 #include "DataFormatsTRD/RawDataStats.h"
 #include <fstream>
+#include <memory>
+#include <vector>
 
 using namespace o2::framework;
 
@@ -46,6 +48,8 @@ class DataReaderTask : public Task
   CruRawReader mReader; // this will do the parsing, of raw data passed directly through the flp(no compression)
                         // we pull the data from the vectors build message and pass on.
                         // they will internally produce a vector of digits and a vector tracklets and associated indexing.
+  std::vector<std::unique_ptr<CruRawReader>> mHelperReaders; // additional readers for multi-threaded parsing, merged into mReader after each TF
+  int mNThreads{1};                                          // number of threads parsing different input messages of a TF concurrently
 
   bool mVerbose{false};          // verbos output general debuggign and info output.
   bool mDataVerbose{false};      // verbose output of data unpacking
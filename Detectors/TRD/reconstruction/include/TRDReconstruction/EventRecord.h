@@ -64,6 +64,9 @@ class EventRecord
   void incTime(float duration) { mTimeTaken += duration; }
   void setIsCalibTrigger() { mIsCalibTrigger = true; }
 
+  // append the data of another record for the same bunch crossing, the other record is left empty
+  void merge(EventRecord& other);
+
  private:
   BCData mBCData;                       /// orbit and Bunch crossing data of the physics trigger
   std::vector<Digit> mDigits{};         /// digit data, for this event
@@ -111,6 +114,10 @@ class EventRecordContainer
   void reset();
   void accumulateStats();
 
+  // add the event records and statistics from another container (e.g. filled by another thread),
+  // records of the same interaction are combined, the data of the other container is appended
+  void merge(EventRecordContainer& other);
+
  private:
   int mCurrEventRecord = 0;
   std::vector<EventRecord> mEventRecords;
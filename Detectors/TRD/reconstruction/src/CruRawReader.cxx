@@ -72,7 +72,7 @@ bool CruRawReader::checkRDH(const o2::header::RDHAny* rdh)
   TRDFeeID feeid;
   feeid.word = o2::raw::RDHUtils::getFEEID(rdh);
   if (((feeid.word) >> 4) == 0xfff) { // error condition is 0xfff? as the end point is known to the cru, but the rest is configured.
-    if (mMaxErrsPrinted > 0) {
+    if (mPrintLimits->maxErrs > 0) {
       LOG(error) << "RDH check failed due to 0xfff. FLP not configured, call TRD on call. Whole feeid = " << std::hex << (unsigned int)feeid.word;
       checkNoErr();
     }
@@ -80,7 +80,7 @@ bool CruRawReader::checkRDH(const o2::header::RDHAny* rdh)
     return false;
   }
   if (feeid.supermodule > 17) {
-    if (mMaxWarnPrinted > 0) {
+    if (mPrintLimits->maxWarn > 0) {
       LOG(warn) << "Wrong supermodule number " << std::dec << (int)feeid.supermodule << " detected in RDH. Whole feeid : " << std::hex << (unsigned int)feeid.word;
       checkNoWarn();
     }
@@ -88,7 +88,7 @@ bool CruRawReader::checkRDH(const o2::header::RDHAny* rdh)
     return false;
   }
   if (o2::raw::RDHUtils::getMemorySize(rdh) <= 0) {
-    if (mMaxWarnPrinted > 0) {
+    if (mPrintLimits->maxWarn > 0) {
       LOG(warn) << "Received RDH header with invalid memory size (<= 0) ";
       checkNoWarn();
     }
@@ -101,7 +101,7 @@ bool CruRawReader::checkRDH(const o2::header::RDHAny* rdh)
 bool CruRawReader::compareRDH(const o2::header::RDHAny* rdhPrev, const o2::header::RDHAny* rdhCurr)
 {
   if (o2::raw::RDHUtils::getFEEID(rdhPrev) != o2::raw::RDHUtils::getFEEID(rdhCurr)) {
-    if (mMaxWarnPrinted > 0) {
+    if (mPrintLimits->maxWarn > 0) {
       LOG(warn) << "ERDH FEEID are not identical in rdh.";
       checkNoWarn();
     }
@@ -109,7 +109,7 @@ bool CruRawReader::compareRDH(const o2::header::RDHAny* rdhPrev, const o2::heade
     return false;
   }
   if (o2::raw::RDHUtils::getEndPointID(rdhPrev) != o2::raw::RDHUtils::getEndPointID(rdhCurr)) {
-    if (mMaxWarnPrinted > 0) {
+    if (mPrintLimits->maxWarn > 0) {
       LOG(warn) << "ERDH  EndPointID are not identical in rdh.";
       checkNoWarn();
     }
@@ -117,7 +117,7 @@ bool CruRawReader::compareRDH(const o2::header::RDHAny* rdhPrev, const o2::heade
     return false;
   }
   if (o2::raw::RDHUtils::getTriggerOrbit(rdhPrev) != o2::raw::RDHUtils::getTriggerOrbit(rdhCurr)) {
-    if (mMaxWarnPrinted > 0) {
+    if (mPrintLimits->maxWarn > 0) {
       LOG(warn) << "ERDH  Orbit are not identical in rdh.";
       checkNoWarn();
     }
@@ -125,7 +125,7 @@ bool CruRawReader::compareRDH(const o2::header::RDHAny* rdhPrev, const o2::heade
     return false;
   }
   if (o2::raw::RDHUtils::getCRUID(rdhPrev) != o2::raw::RDHUtils::getCRUID(rdhCurr)) {
-    if (mMaxWarnPrinted > 0) {
+    if (mPrintLimits->maxWarn > 0) {
       LOG(warn) << "ERDH  CRUID are not identical in rdh.";
       checkNoWarn();
     }
@@ -134,7 +134,7 @@ bool CruRawReader::compareRDH(const o2::header::RDHAny* rdhPrev, const o2::heade
   }
   uint8_t rdhExpected = o2::raw::RDHUtils::getPacketCounter(rdhPrev) + 1; // packet counter is 8 bits
   if (o2::raw::RDHUtils::getPacketCounter(rdhCurr) != rdhExpected) {
-    if (mMaxWarnPrinted > 0) {
+    if (mPrintLimits->maxWarn > 0) {
       LOG(warn) << "ERDH  PacketCounters are not sequential in rdh.";
       checkNoWarn();
     }
@@ -152,7 +152,7 @@ int CruRawReader::processHBFs()
   uint32_t totalDataInputSize = 0;
   mTotalHBFPayLoad = 0;
   if (o2::raw::RDHUtils::getStop(rdh)) {
-    if (mMaxErrsPrinted > 0) {
+    if (mPrintLimits->maxErrs > 0) {
       LOGP(error, "First RDH for given HBF for FEE ID {:#04x} has stop bit set", o2::raw::RDHUtils::getFEEID(rdh));
       checkNoErr();
     }
@@ -190,7 +190,7 @@ int CruRawReader::processHBFs()
 
     if (totalDataInputSize + memorySize >= mDataBufferSize) {
       // the size of the current RDH is larger than it can possibly be (we still expect a STOP RDH)
-      if (mMaxErrsPrinted > 0) {
+      if (mPrintLimits->maxErrs > 0) {
         LOGP(error, "RDH memory size of {} + already read data size {} = {} >= {} (total available buffer size) from CRU with FEE ID {:#04x}",
              memorySize, totalDataInputSize, memorySize + totalDataInputSize, mDataBufferSize, mFEEID.word);
         checkNoErr();
@@ -253,7 +253,7 @@ bool CruRawReader::parseDigitHCHeaders(int hcid)
     mDigitHCHeader.minor = 42;
     mDigitHCHeader.numberHCW = mHalfChamberWords;
     if (mHalfChamberWords == 0 || mHalfChamberMajor == 0) {
-      if (mMaxWarnPrinted > 0) {
+      if (mPrintLimits->maxWarn > 0) {
         LOG(alarm) << "DigitHCHeader is corrupted and using a hack as workaround is not configured";
         checkNoWarn(false);
       }
@@ -265,7 +265,7 @@ bool CruRawReader::parseDigitHCHeaders(int hcid)
   int halfChamberIdHeader = mDigitHCHeader.supermodule * NHCPERSEC + mDigitHCHeader.stack * NLAYER * 2 + mDigitHCHeader.layer * 2 + mDigitHCHeader.side;
   if (hcid != halfChamberIdHeader) {
     incrementErrors(DigitHCHeaderMismatch, hcid, fmt::format("HCID mismatch detected. HCID from DigitHCHeader: {}, HCID from RDH: {}", halfChamberIdHeader, hcid));
-    if (mMaxWarnPrinted > 0) {
+    if (mPrintLimits->maxWarn > 0) {
       LOGF(warning, "HCID mismatch in DigitHCHeader detected for ref HCID %i. DigitHCHeader says HCID is %i", hcid, halfChamberIdHeader);
       checkNoWarn();
     }
@@ -275,7 +275,7 @@ bool CruRawReader::parseDigitHCHeaders(int hcid)
   int additionalHeaderWords = mDigitHCHeader.numberHCW;
   if (additionalHeaderWords >= 3) {
     incrementErrors(DigitHeaderCountGT3, hcid);
-    if (mMaxWarnPrinted > 0) {
+    if (mPrintLimits->maxWarn > 0) {
       LOGF(warn, "Found too many additional words (%i) in DigitHCHeader 0x%08x", additionalHeaderWords, mDigitHCHeader.word);
       checkNoWarn();
     }
@@ -419,7 +419,7 @@ bool CruRawReader::processHalfCRU(int iteration)
     return true;
   }
   if (mCRUEndpoint != mCurrentHalfCRUHeader.EndPoint) {
-    if (mMaxWarnPrinted > 0) {
+    if (mPrintLimits->maxWarn > 0) {
       LOGF(warn, "End point mismatch detected. HalfCRUHeader says %i, RDH says %i", mCurrentHalfCRUHeader.EndPoint, mCRUEndpoint);
       checkNoWarn();
     }
@@ -433,7 +433,7 @@ bool CruRawReader::processHalfCRU(int iteration)
     // for the second trigger (and thus second HalfCRUHeader we see) we can do some more sanity checks
     // in case one check fails, we try to go to the next HalfCRUHeader
     if (mCurrentHalfCRUHeader.EndPoint != mPreviousHalfCRUHeader.EndPoint) {
-      if (mMaxWarnPrinted > 0) {
+      if (mPrintLimits->maxWarn > 0) {
         LOGF(warn, "For current half-CRU index %i we have end point %i, while the previous end point was %i", iteration, mCurrentHalfCRUHeader.EndPoint, mPreviousHalfCRUHeader.EndPoint);
         checkNoWarn();
       }
@@ -443,7 +443,7 @@ bool CruRawReader::processHalfCRU(int iteration)
       return true;
     }
     if (mCurrentHalfCRUHeader.StopBit != mPreviousHalfCRUHeader.StopBit) {
-      if (mMaxWarnPrinted > 0) {
+      if (mPrintLimits->maxWarn > 0) {
         LOGF(warn, "For current half-CRU index %i we have stop bit %i, while the previous stop bit was %i", iteration, mCurrentHalfCRUHeader.StopBit, mPreviousHalfCRUHeader.StopBit);
         checkNoWarn();
       }
@@ -458,7 +458,7 @@ bool CruRawReader::processHalfCRU(int iteration)
 
   //can this half cru length fit into the available space of the rdh accumulated payload
   if (totalHalfCRUDataLength32 > (mTotalHBFPayLoad / 4) - mHBFoffset32) {
-    if (mMaxWarnPrinted > 0) {
+    if (mPrintLimits->maxWarn > 0) {
       LOGP(warn, "HalfCRU header says it contains more data ({} 32-bit words) than is remaining in the payload ({} 32-bit words)", totalHalfCRUDataLength32, ((mTotalHBFPayLoad / 4) - mHBFoffset32));
       checkNoWarn();
     }
@@ -542,7 +542,7 @@ bool CruRawReader::processHalfCRU(int iteration)
       mHBFoffset32 += trackletWordsRead;
       if (mCurrentHalfCRUHeader.EventType == ETYPEPHYSICSTRIGGER &&
           endOfCurrentLink - mHBFoffset32 >= 8) {
-        if (mMaxWarnPrinted > 0) {
+        if (mPrintLimits->maxWarn > 0) {
           LOGF(warn, "After successfully parsing the tracklet data for link %i there are %u words remaining which did not get parsed", currentlinkindex, endOfCurrentLink - mHBFoffset32);
           checkNoWarn();
         }
@@ -574,7 +574,7 @@ bool CruRawReader::processHalfCRU(int iteration)
           continue; // move to next link of this half-CRU
         }
         if (mHBFoffset32 - offsetBeforeDigitParsing != 1U + mDigitHCHeader.numberHCW) {
-          if (mMaxErrsPrinted > 0) {
+          if (mPrintLimits->maxErrs > 0) {
             LOGF(error, "Did not read as many digit headers (%i) as expected (%i)",
                  mHBFoffset32 - offsetBeforeDigitParsing, mDigitHCHeader.numberHCW + 1);
             checkNoErr();
@@ -605,7 +605,7 @@ bool CruRawReader::processHalfCRU(int iteration)
           if (endOfCurrentLink - mHBFoffset32 >= 8) {
             // check if some data is lost (probably due to bug in CRU user logic)
             // we should have max 7 padding words to align the link to 256 bits
-            if (mMaxWarnPrinted > 0) {
+            if (mPrintLimits->maxWarn > 0) {
               LOGF(warn, "After successfully parsing the digit data for link %i there are %u words remaining which did not get parsed", currentlinkindex, endOfCurrentLink - mHBFoffset32);
               checkNoWarn();
             }
@@ -1016,7 +1016,7 @@ int CruRawReader::parseTrackletLinkData(int linkSize32, int& hcid, int& wordsRej
   } // end of state machine
 
   if (mTrackletHCHeaderState == 1 && trackletsFound == 0) {
-    if (mMaxErrsPrinted > 0) {
+    if (mPrintLimits->maxErrs > 0) {
       LOG(error) << "We found a TrackletHCHeader in mode 1, but did not add any tracklets";
       checkNoErr();
     }
@@ -1094,7 +1094,7 @@ void CruRawReader::run()
     int dataRead = processHBFs();
 
     if (dataRead < 0) {
-      if (mMaxWarnPrinted > 0) {
+      if (mPrintLimits->maxWarn > 0) {
         LOG(warn) << "Received invalid RDH, rejecting given HBF entirely";
         checkNoWarn();
       }
@@ -1156,10 +1156,25 @@ void CruRawReader::reset()
   mWordsRejected = 0;
 }
 
+void CruRawReader::merge(CruRawReader& other)
+{
+  mEventRecords.merge(other.mEventRecords);
+  mTrackletsFound += other.mTrackletsFound;
+  mDigitsFound += other.mDigitsFound;
+  mDigitWordsRead += other.mDigitWordsRead;
+  mDigitWordsRejected += other.mDigitWordsRejected;
+  mTrackletWordsRead += other.mTrackletWordsRead;
+  mTrackletWordsRejected += other.mTrackletWordsRejected;
+  mWordsRejected += other.mWordsRejected;
+  mHalfChamberHeaderOK.insert(other.mHalfChamberHeaderOK.begin(), other.mHalfChamberHeaderOK.end());
+  mHalfChamberMismatches.insert(other.mHalfChamberMismatches.begin(), other.mHalfChamberMismatches.end());
+  other.reset();
+}
+
 void CruRawReader::checkNoWarn(bool silently)
 {
   if (!mOptions[TRDVerboseErrorsBit]) {
-    if (--mMaxWarnPrinted == 0) {
+    if (--mPrintLimits->maxWarn == 0) {
       if (silently) {
         // put the warning message into the log file without polluting the InfoLogger
         LOG(warn) << "Warnings limit reached, the following ones will be suppressed";
@@ -1174,7 +1189,7 @@ void CruRawReader::checkNoWarn(bool silently)
 void CruRawReader::checkNoErr()
 {
   if (!mOptions[TRDVerboseErrorsBit]) {
-    if (--mMaxErrsPrinted == 0) {
+    if (--mPrintLimits->maxErrs == 0) {
       LOG(error) << "Errors limit reached, the following ones will be suppressed";
     }
   }
@@ -102,7 +102,8 @@ WorkflowSpec defineDataProcessing(ConfigContext const& cfgc)
     Options{{"log-max-errors", VariantType::Int, 20, {"maximum number of errors to log"}},
             {"log-max-warnings", VariantType::Int, 20, {"maximum number of warnings to log"}},
             {"number-of-TBs", VariantType::Int, -1, {"set to >=0 in order to overwrite number of time bins"}},
-            {"every-nth-tf", VariantType::Int, 1, {"process only every n-th TF"}}}});
+            {"every-nth-tf", VariantType::Int, 1, {"process only every n-th TF"}},
+            {"nthreads", VariantType::Int, 1, {"number of threads parsing the input messages of a TF concurrently"}}}});
 
   if (!cfgc.options().get<bool>("disable-root-output")) {
     workflow.emplace_back(o2::trd::getTRDDigitWriterSpec(false, false));
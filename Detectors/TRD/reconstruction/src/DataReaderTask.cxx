@@ -26,18 +26,39 @@
 #include "DataFormatsCTP/TriggerOffsetsParam.h"
 #include "DataFormatsTRD/Constants.h"
 
+#include <algorithm>
+
 namespace o2::trd
 {
 
 void DataReaderTask::init(InitContext& ic)
 {
-  mReader.setMaxErrWarnPrinted(ic.options().get<int>("log-max-errors"), ic.options().get<int>("log-max-warnings"));
+  mNThreads = std::max(1, ic.options().get<int>("nthreads"));
+#ifndef WITH_OPENMP
+  if (mNThreads > 1) {
+    LOGP(warning, "Built without OpenMP, parsing with 1 thread instead of {}", mNThreads);
+    mNThreads = 1;
+  }
+#endif
+  mHelperReaders.clear();
+  for (int ith = 1; ith < mNThreads; ++ith) {
+    mHelperReaders.emplace_back(std::make_unique<CruRawReader>());
+  }
   int nTimeBins = ic.options().get<int>("number-of-TBs");
   if (nTimeBins >= 0) {
     LOGP(info, "Number of time bins set to {} externally", nTimeBins);
-    mReader.setNumberOfTimeBins(nTimeBins);
   }
-  mReader.configure(mTrackletHCHeaderState, mHalfChamberWords, mHalfChamberMajor, mOptions);
+  mReader.setMaxErrWarnPrinted(ic.options().get<int>("log-max-errors"), ic.options().get<int>("log-max-warnings"));
+  for (int ith = 0; ith < mNThreads; ++ith) {
+    auto& reader = ith == 0 ? mReader : *mHelperReaders[ith - 1];
+    if (ith > 0) {
+      reader.sharePrintLimits(mReader); // the limits apply to the device, not to each thread
+    }
+    if (nTimeBins >= 0) {
+      reader.setNumberOfTimeBins(nTimeBins);
+    }
+    reader.configure(mTrackletHCHeaderState, mHalfChamberWords, mHalfChamberMajor, mOptions);
+  }
   mProcessEveryNthTF = ic.options().get<int>("every-nth-tf");
 }
 
@@ -45,6 +66,9 @@ void DataReaderTask::endOfStream(o2::framework::EndOfStreamContext& ec)
 {
   LOGF(info, "At EoS we have read: %lu Digits, %lu Tracklets. Received %.3f MB input data and rejected %.3f MB",
        mDigitsTotal, mTrackletsTotal, mDatasizeInTotal / (1024. * 1024.), (float)mWordsRejectedTotal * 4. / (1024. * 1024.));
+  for (auto& reader : mHelperReaders) {
+    mReader.merge(*reader);
+  }
   mReader.printHalfChamberHeaderReport();
 }
 
@@ -57,6 +81,9 @@ void DataReaderTask::finaliseCCDB(ConcreteDataMatcher& matcher, void* obj)
   } else if (matcher == ConcreteDataMatcher("TRD", "LinkToHcid", 0)) {
     LOG(info) << "Updated Link ID to HCID mapping";
     mReader.setLinkMap((const o2::trd::LinkToHCIDMapping*)obj);
+    for (auto& reader : mHelperReaders) {
+      reader->setLinkMap((const o2::trd::LinkToHCIDMapping*)obj);
+    }
     return;
   }
 }
@@ -113,22 +140,48 @@ void DataReaderTask::run(ProcessingContext& pc)
   size_t datasizeInTF = 0;
   std::vector<InputSpec> sel{InputSpec{"filter", ConcreteDataTypeMatcher{"TRD", "RAWDATA"}}};
   uint64_t tfCount = 0;
+  std::vector<DataRef> refs;
   for (auto& ref : InputRecordWalker(pc.inputs(), sel)) {
-    // loop over incoming HBFs from all half-CRUs (typically 128 * 72 iterations per TF)
+    // incoming HBFs from all half-CRUs (typically 128 * 72 per TF)
+    refs.push_back(ref);
+    tfCount = DataRefUtils::getHeader<o2::header::DataHeader*>(ref)->tfCounter;
+    datasizeInTF += DataRefUtils::getPayloadSize(ref);
+  }
+  auto parseInput = [this](CruRawReader& reader, const DataRef& ref) {
     const auto* dh = DataRefUtils::getHeader<o2::header::DataHeader*>(ref);
-    tfCount = dh->tfCounter;
     const char* payloadIn = ref.payload;
     auto payloadInSize = DataRefUtils::getPayloadSize(ref);
     if (mOptions[TRDVerboseBit]) {
       LOGP(info, "Found input [{}/{}/{:#x}] TF#{} 1st_orbit:{} Payload {} : ",
            dh->dataOrigin.str, dh->dataDescription.str, dh->subSpecification, dh->tfCounter, dh->firstTForbit, payloadInSize);
     }
-    mReader.setDataBuffer(payloadIn);
-    mReader.setDataBufferSize(payloadInSize);
-    mReader.run();
-    datasizeInTF += payloadInSize;
+    reader.setDataBuffer(payloadIn);
+    reader.setDataBufferSize(payloadInSize);
+    reader.run();
     if (mOptions[TRDVerboseBit]) {
-      LOG(info) << "relevant vectors to read : " << mReader.getTrackletsFound() << " tracklets and " << mReader.getDigitsFound() << " compressed digits";
+      LOG(info) << "relevant vectors to read : " << reader.getTrackletsFound() << " tracklets and " << reader.getDigitsFound() << " compressed digits";
+    }
+  };
+  int nThreads = std::min(mNThreads, (int)refs.size());
+  if (nThreads <= 1) {
+    for (const auto& ref : refs) {
+      parseInput(mReader, ref);
+    }
+  } else {
+    // each thread parses a contiguous block of input messages with its own reader, the readers are then merged
+    // in the order of the blocks, so that the event records and their data are ordered as for a single reader
+#ifdef WITH_OPENMP
+#pragma omp parallel for schedule(static, 1) num_threads(nThreads)
+#endif
+    for (int ith = 0; ith < nThreads; ++ith) {
+      auto& reader = ith == 0 ? mReader : *mHelperReaders[ith - 1];
+      size_t first = refs.size() * ith / nThreads, last = refs.size() * (ith + 1) / nThreads;
+      for (size_t iref = first; iref < last; ++iref) {
+        parseInput(reader, refs[iref]);
+      }
+    }
+    for (int ith = 1; ith < nThreads; ++ith) {
+      mReader.merge(*mHelperReaders[ith - 1]);
     }
   }
 
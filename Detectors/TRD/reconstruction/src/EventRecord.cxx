@@ -56,6 +56,22 @@ void EventRecord::sortData(bool sortDigits)
   }
 }
 
+void EventRecord::merge(EventRecord& other)
+{
+  mDigits.insert(mDigits.end(), other.mDigits.begin(), other.mDigits.end());
+  mTracklets.insert(mTracklets.end(), other.mTracklets.begin(), other.mTracklets.end());
+  other.mDigits.clear();
+  other.mTracklets.clear();
+  mTimeTaken += other.mTimeTaken;
+  mTimeTakenForDigits += other.mTimeTakenForDigits;
+  mTimeTakenForTracklets += other.mTimeTakenForTracklets;
+  mIsCalibTrigger |= other.mIsCalibTrigger;
+  for (int hcid = 0; hcid < constants::MAXHALFCHAMBER; ++hcid) {
+    mCounters.mLinkWords[hcid] += other.mCounters.mLinkWords[hcid];
+    mCounters.mLinkErrorFlag[hcid] |= other.mCounters.mLinkErrorFlag[hcid];
+  }
+}
+
 void EventRecordContainer::sendData(o2::framework::ProcessingContext& pc, bool generatestats, bool sortDigits, bool sendLinkStats)
 {
   //at this point we know the total number of tracklets and digits and triggers.
@@ -125,6 +141,30 @@ void EventRecordContainer::setCurrentEventRecord(const InteractionRecord& ir)
   }
 }
 
+void EventRecordContainer::merge(EventRecordContainer& other)
+{
+  for (auto& event : other.mEventRecords) {
+    setCurrentEventRecord(event.getBCData());
+    getCurrentEventRecord().merge(event);
+  }
+  for (int hcid = 0; hcid < constants::MAXHALFCHAMBER; ++hcid) {
+    mTFStats.mLinkErrorFlag[hcid] |= other.mTFStats.mLinkErrorFlag[hcid];
+    mTFStats.mLinkNoData[hcid] += other.mTFStats.mLinkNoData[hcid];
+    mTFStats.mLinkWords[hcid] += other.mTFStats.mLinkWords[hcid];
+    mTFStats.mLinkWordsRead[hcid] += other.mTFStats.mLinkWordsRead[hcid];
+    mTFStats.mLinkWordsRejected[hcid] += other.mTFStats.mLinkWordsRejected[hcid];
+    mTFStats.mParsingOK[hcid] += other.mTFStats.mParsingOK[hcid];
+  }
+  for (int error = 0; error < TRDLastParsingError; ++error) {
+    mTFStats.mParsingErrors[error] += other.mTFStats.mParsingErrors[error];
+  }
+  mTFStats.mParsingErrorsByLink.insert(mTFStats.mParsingErrorsByLink.end(), other.mTFStats.mParsingErrorsByLink.begin(), other.mTFStats.mParsingErrorsByLink.end());
+  for (int version = 0; version < (int)mTFStats.mDataFormatRead.size(); ++version) {
+    mTFStats.mDataFormatRead[version] += other.mTFStats.mDataFormatRead[version];
+  }
+  other.reset();
+}
+
 void EventRecordContainer::reset()
 {
   mEventRecords.clear();
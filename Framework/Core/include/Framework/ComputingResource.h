@@ -42,6 +42,11 @@ struct ComputingResource {
   unsigned short startPort = 0;
   unsigned short lastPort = 0;
   unsigned short usedPorts = 0;
+  /// The NUMA node the device was placed on, -1 if no placement was done.
+  int numaNode = -1;
+  /// The CPUs the device and its threads are pinned to, in
+  /// cpulist format (e.g. "0-7,16-23"). Empty if not pinned.
+  std::string cpuSet = "";
 };
 
 } // namespace o2::framework
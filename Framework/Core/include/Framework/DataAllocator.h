@@ -288,8 +288,29 @@ class DataAllocator
   /// Note: messageable objects with ROOT dictionary are preferably sent unserialized.
   /// Use @a ROOTSerialized type wrapper to force ROOT serialization. Same applies to
   /// types which do not implement the ClassDef interface but have a dictionary.
+  ///
+  /// Note: ROOT serialized objects which were obtained from a CCDB input are
+  /// serialized only once per CCDB update. Subsequent snapshots of the same object
+  /// reuse the serialized buffer.
   template <typename T>
   void snapshot(const Output& spec, T const& object)
+  {
+    snapshot(spec, object, SerializationVersion{0});
+  }
+
+  /// Version of a ROOT serialized object, to be used in snapshot.
+  struct SerializationVersion {
+    uint64_t value;
+  };
+
+  /// Like snapshot(spec, object), however for ROOT serialized objects the
+  /// serialized buffer is kept around and shared with all the subsequent
+  /// snapshots of the same object (i.e. same address and type) with the same
+  /// @a version, avoiding to stream it again. The @a version must be changed
+  /// whenever the content of the object changes. A version of 0 enables the
+  /// caching only for objects coming from the CCDB.
+  template <typename T>
+  void snapshot(const Output& spec, T const& object, SerializationVersion version)
   {
     auto& proxy = mRegistry.get<MessageContext>().proxy();
     fair::mq::MessagePtr payloadMessage;
@@ -328,7 +349,7 @@ class DataAllocator
 
         serializationType = o2::header::gSerializationMethodNone;
       } else if constexpr (has_root_dictionary<ElementType>::value) {
-        return snapshot(spec, ROOTSerialized<T const>(object));
+        return snapshot(spec, ROOTSerialized<T const>(object), version);
       } else {
         static_assert(always_static_assert_v<T>,
                       "value type of std::vector not supported by API, supported types:"
@@ -352,6 +373,15 @@ class DataAllocator
       }
       serializationType = o2::header::gSerializationMethodNone;
     } else if constexpr (has_root_dictionary<T>::value == true || is_specialization_v<T, ROOTSerialized> == true) {
+      void const* objectPtr = nullptr;
+      if constexpr (is_specialization_v<T, ROOTSerialized> == true) {
+        objectPtr = &object();
+      } else {
+        objectPtr = &object;
+      }
+      if (adoptFromSerializationCache(spec, routeIndex, objectPtr, typeid(T).hash_code(), version)) {
+        return;
+      }
       // Serialize a snapshot of an object with root dictionary
       payloadMessage = proxy.createOutputMessage(routeIndex);
       payloadMessage->Rebuild(4096, {64});
@@ -391,6 +421,9 @@ class DataAllocator
         typename root_serializer<T>::serializer().Serialize(*payloadMessage, &object, TClass::GetClass(typeid(T)));
       }
       serializationType = o2::header::gSerializationMethodROOT;
+      if (version.value) {
+        mRegistry.get<MessageContext>().addToSerializationCache(objectPtr, typeid(T).hash_code(), version.value, payloadMessage);
+      }
     } else {
       static_assert(always_static_assert_v<T>,
                     "data type T not supported by API, \n specializations available for"
@@ -526,6 +559,11 @@ class DataAllocator
                                                size_t payloadSize);                                 //
 
   Output getOutputByBind(OutputRef&& ref);
+  /// Send the cached serialized buffer of @a object, if there is one matching
+  /// @a type and @a version. If @a version is 0 and @a object comes from the
+  /// CCDB, the version is set to the one of the CCDB object.
+  /// @return true if the cached buffer was sent.
+  bool adoptFromSerializationCache(Output const& spec, RouteIndex routeIndex, void const* object, size_t type, SerializationVersion& version);
   void addPartToContext(RouteIndex routeIndex, fair::mq::MessagePtr&& payload,
                         const Output& spec,
                         o2::header::SerializationMethod serializationMethod);
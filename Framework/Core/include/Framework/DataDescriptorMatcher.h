@@ -21,6 +21,7 @@
 #include <cstdint>
 #include <iosfwd>
 #include <string>
+#include <unordered_map>
 #include <variant>
 #include <vector>
 #include <ostream>
@@ -309,6 +310,50 @@ class DataDescriptorMatcher
   Node mRight;
 };
 
+/// An index over a list of matchers which allows finding the few of them
+/// which can possibly match a given header, rather than trying them all.
+/// Matchers which require an exact origin, description and subSpec are
+/// hashed on those, all the others are kept in a list of wildcards which
+/// are always candidates.
+class DataDescriptorMatcherIndex
+{
+ public:
+  /// Add @a matcher at position @a pos. Positions must be added in increasing order.
+  void add(int pos, DataDescriptorMatcher const& matcher);
+
+  /// Invoke @a f on the position of each matcher which can match @a header,
+  /// in increasing order, until it returns true.
+  /// @return the position for which @a f returned true, -1 if none did.
+  template <typename F>
+  int find(header::DataHeader const& header, F&& f) const
+  {
+    static const std::vector<int> empty;
+    auto exactPos = mExact.find(ConcreteDataMatcher{header.dataOrigin, header.dataDescription, header.subSpecification});
+    auto const& exact = exactPos == mExact.end() ? empty : exactPos->second;
+    // Merge the two sorted lists so that the first matching position wins,
+    // like with a linear scan.
+    auto ei = exact.begin();
+    auto wi = mWildcards.begin();
+    while (ei != exact.end() || wi != mWildcards.end()) {
+      int pos = (wi == mWildcards.end() || (ei != exact.end() && *ei < *wi)) ? *ei++ : *wi++;
+      if (f(pos)) {
+        return pos;
+      }
+    }
+    return -1;
+  }
+
+ private:
+  struct Hash {
+    size_t operator()(ConcreteDataMatcher const& m) const
+    {
+      return std::hash<uint64_t>{}(((uint64_t)m.origin.itg[0] << 32) ^ m.description.itg[0] ^ (m.description.itg[1] * 31) ^ ((uint64_t)m.subSpec * 0x9e3779b97f4a7c15ULL));
+    }
+  };
+  std::unordered_map<ConcreteDataMatcher, std::vector<int>, Hash> mExact;
+  std::vector<int> mWildcards;
+};
+
 } // namespace o2::framework::data_matcher
 
 // This is to work around CLING issues when parsing
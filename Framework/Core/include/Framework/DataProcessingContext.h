@@ -13,7 +13,11 @@
 
 #include "Framework/DataRelayer.h"
 #include "Framework/AlgorithmSpec.h"
+#include "Framework/InputRecord.h"
+#include <atomic>
+#include <condition_variable>
 #include <functional>
+#include <mutex>
 
 namespace o2::framework
 {
@@ -27,7 +31,8 @@ struct DataProcessorContext {
   DataProcessorContext(DataProcessorContext const&) = delete;
   DataProcessorContext() = default;
   // These are specific of a given context and therefore
-  // not shared by threads.
+  // not shared by threads. The streams keep track of their own
+  // activity in the StreamContext.
   bool* wasActive = nullptr;
   bool allDone = false;
   /// Latest run number we processed globally for this DataProcessor.
@@ -39,7 +44,6 @@ struct DataProcessorContext {
 
   // FIXME: move stuff here from the list below... ;-)
   ServiceRegistry* registry = nullptr;
-  std::vector<DataRelayer::RecordAction> completed;
   std::vector<ExpirationHandler> expirationHandlers;
   AlgorithmSpec::InitCallback init;
   AlgorithmSpec::ProcessCallback statefulProcess;
@@ -123,11 +127,30 @@ struct DataProcessorContext {
   /// Callbacks for services to be executed before we enter the event loop
   mutable std::vector<ServicePreLoopHandle> preLoopHandles;
 
+  /// When multiple streams process timeslices concurrently, each computation
+  /// takes a ticket when it starts and sends its outputs only once all the
+  /// computations with an earlier ticket did so.
+  bool orderedOutputs = false;
+  std::atomic<uint64_t> nextOutputTicket = 0;
+  uint64_t nextOutputToSend = 0;
+  std::mutex outputOrderMutex;
+  std::condition_variable outputOrderCondition;
+  /// Only one stream at the time can send on the channels, be it
+  /// outputs, forwarded inputs or end of stream.
+  std::mutex sendMutex;
+  /// Serialises what changes the state of the whole device, i.e. the
+  /// expiration of dangling inputs and the end of stream handling.
+  std::recursive_mutex streamingStateMutex;
+
   /// Wether or not the associated DataProcessor can forward things early
   bool canForwardEarly = true;
   bool isSink = false;
   bool balancingInputs = true;
 
+  /// The lookup tables for the bindings of the inputs of the device,
+  /// which never change, built once in Init and shared by the streams.
+  std::shared_ptr<InputRecord::InputIndex const> inputIndex;
+
   std::function<void(o2::framework::RuntimeErrorRef e, InputRecord& record)> errorHandling;
   std::function<void(o2::framework::RuntimeErrorRef e)> initErrorHandling;
 };
@@ -64,6 +64,11 @@ enum struct ProcessingStatsId : short {
   RESOURCES_MISSING,
   RESOURCES_INSUFFICIENT,
   RESOURCES_SATISFACTORY,
+  OUTPUT_MESSAGES_CREATED,
+  OUTPUT_MESSAGES_POOLED,
+  RATE_LIMIT_TFS_IN_FLIGHT,
+  RATE_LIMIT_SHM_OCCUPANCY,
+  RATE_LIMIT_LATENCY_MS,
   AVAILABLE_MANAGED_SHM_BASE = 512,
 };
 
@@ -148,6 +148,14 @@ class DataRelayer
   /// @returns the actions ready to be performed.
   void getReadyToProcess(std::vector<RecordAction>& completed);
 
+  /// When more than one stream asks for the actions ready to be performed,
+  /// a slot handed out to one of them must not be handed out to another
+  /// before the first one is done with it. With @a claim true, the slots
+  /// returned by getReadyToProcess are skipped until released.
+  void setClaimSlots(bool claim);
+  /// Make @a slot available again to getReadyToProcess.
+  void releaseSlot(TimesliceSlot slot);
+
   /// Returns an input registry associated to the given timeslice and gives
   /// ownership to the caller. This is because once the inputs are out of the
   /// DataRelayer they need to be deleted once the processing is concluded.
@@ -208,10 +216,15 @@ class DataRelayer
   std::vector<size_t> mDistinctRoutesIndex;
   std::vector<InputSpec> mInputs;
   std::vector<data_matcher::DataDescriptorMatcher> mInputMatchers;
+  /// Lookup of the distinct routes which can match a given header.
+  data_matcher::DataDescriptorMatcherIndex mInputMatchersIndex;
   std::vector<data_matcher::VariableContext> mVariableContextes;
   std::vector<CacheEntryStatus> mCachedStateMetrics;
   std::vector<PruneOp> mPruneOps;
   size_t mMaxLanes;
+  bool mClaimSlots = false;
+  /// Slots currently being processed by one of the streams.
+  std::vector<bool> mClaimedSlots;
 
   O2_LOCKABLE_NAMED(std::recursive_mutex, mMutex, "data relayer mutex");
 };
@@ -42,6 +42,30 @@ struct DeviceMetricsHelper {
   static bool processMetric(ParsedMetricMatch& results,
                             DeviceMetricsInfo& info,
                             NewMetricCallback newMetricCallback = nullptr);
+
+  /// Helper function to parse a metric id registration in the form
+  /// "[METRIC_ID] <id> <name>".
+  /// @return true if @a s is a valid registration, filling @a id and @a name.
+  static bool parseMetricId(std::string_view const s, uint32_t& id, std::string_view& name);
+
+  /// @return true if the @a size bytes at @a data are a BinaryMetric.
+  static bool isBinaryMetric(char const* data, size_t size)
+  {
+    uint32_t magic;
+    if (size != sizeof(BinaryMetric)) {
+      return false;
+    }
+    memcpy(&magic, data, sizeof(magic));
+    return magic == BinaryMetric::MAGIC;
+  }
+
+  /// Stores a binary metric in the slot @a metricIndex of @a info, which
+  /// must have been created by a previous processMetric.
+  static bool processBinaryMetric(BinaryMetric const& metric, size_t metricIndex, DeviceMetricsInfo& info);
+
+  /// Stores the value in @a match (or @a stringValue for string metrics)
+  /// in the already existing metric at @a metricIndex.
+  static bool storeMetric(ParsedMetricMatch const& match, StringMetric const& stringValue, size_t metricIndex, DeviceMetricsInfo& info);
   /// @return the index in metrics for the information of given metric
   static size_t metricIdxByName(const std::string& name,
                                 const DeviceMetricsInfo& info);
@@ -100,6 +100,26 @@ struct ParsedMetricMatch {
   char const* endStringValue;
 };
 
+/// Fixed size record used by devices to send a numeric metric to the driver
+/// without going through its text representation. The id must have been
+/// associated to a metric name beforehand with a message in the form
+///
+/// [METRIC_ID] <id> <name>
+///
+/// which is sent right after the first textual update of the metric.
+struct BinaryMetric {
+  static constexpr uint32_t MAGIC = 0x4d4c5044; // "DPLM"
+  uint32_t magic = MAGIC;
+  uint32_t id = 0;
+  uint64_t timestamp = 0;
+  MetricType type = MetricType::Unknown;
+  union {
+    int intValue;
+    float floatValue;
+    uint64_t uint64Value = 0;
+  };
+};
+
 template <typename T>
 inline constexpr size_t metricStorageSize()
 {
@@ -11,6 +11,7 @@
 #ifndef O2_FRAMEWORK_FAIRMQDEVICEPROXY_H_
 #define O2_FRAMEWORK_FAIRMQDEVICEPROXY_H_
 
+#include <atomic>
 #include <memory>
 
 #include "Framework/ChannelInfo.h"
@@ -29,6 +30,8 @@ struct DataHeader;
 
 namespace o2::framework
 {
+class OutputMessagePool;
+
 /// Helper class to hide fair::mq::Device headers in the DataAllocator header.
 /// This is done because fair::mq::Device brings in a bunch of boost.mpl /
 /// boost.fusion stuff, slowing down compilation times enourmously.
@@ -76,7 +79,14 @@ class FairMQDeviceProxy
   ForwardChannelState& getForwardChannelState(ChannelIndex channelIndex);
 
   [[nodiscard]] std::unique_ptr<fair::mq::Message> createOutputMessage(RouteIndex routeIndex) const;
+  /// Create a payload message for the given output route. If the
+  /// associated OutputSpec requested an output pool (via the
+  /// "output-pool-size" metadata, in MB), the message is taken from
+  /// the pool, falling back to the transport allocator when exhausted.
   [[nodiscard]] std::unique_ptr<fair::mq::Message> createOutputMessage(RouteIndex routeIndex, const size_t size) const;
+  /// Retrieve and reset the number of output messages created (and of those
+  /// recycled from an output pool) since the last invocation.
+  std::pair<int64_t, int64_t> consumeOutputMessagesCount();
 
   [[nodiscard]] std::unique_ptr<fair::mq::Message> createInputMessage(RouteIndex routeIndex) const;
   [[nodiscard]] std::unique_ptr<fair::mq::Message> createInputMessage(RouteIndex routeIndex, const size_t size) const;
@@ -95,6 +105,9 @@ class FairMQDeviceProxy
   std::vector<RouteState> mOutputRoutes;
   std::vector<OutputChannelInfo> mOutputChannelInfos;
   std::vector<OutputChannelState> mOutputChannelStates;
+  std::vector<std::shared_ptr<OutputMessagePool>> mOutputPools;
+  mutable std::atomic<int64_t> mOutputMessagesCreated = 0;
+  mutable std::atomic<int64_t> mOutputMessagesPooled = 0;
 
   std::vector<InputRoute> mInputs;
   std::vector<RouteState> mInputRoutes;
@@ -21,6 +21,7 @@
 #include "Framework/Logger.h"
 #include "Framework/ObjectCache.h"
 #include "Framework/CallbackService.h"
+#include "Framework/StringHelpers.h"
 
 #include "Headers/DataHeader.h"
 
@@ -106,9 +107,28 @@ class InputRecord
     constexpr static size_t INVALID = -1LL;
   };
 
+  /// Lookup tables for the inputs, which only depend on the schema
+  /// and can therefore be built once and shared between records.
+  struct InputIndex {
+    struct Binding {
+      uint32_t hash;
+      int pos;
+      char const* name;
+    };
+    /// The bindings of the inputs, sorted by hash
+    std::vector<Binding> bindings;
+    /// The position in the schema of the route associated to each input
+    std::vector<int> schemaIndices;
+  };
+
+  /// Build the lookup tables for a given schema. Notice the bindings
+  /// point to the strings in @a schema, which must outlive the index.
+  static std::shared_ptr<InputIndex const> buildIndex(std::vector<InputRoute> const& schema);
+
   InputRecord(std::vector<InputRoute> const& inputs,
               InputSpan& span,
-              ServiceRegistryRef);
+              ServiceRegistryRef,
+              std::shared_ptr<InputIndex const> index = nullptr);
 
   /// A deleter type to be used with unique_ptr, which can be marked that
   /// it does not own the underlying resource and thus should not delete it.
@@ -184,6 +204,9 @@ class InputRecord
   };
 
   int getPos(const char* name) const;
+  /// @return the position of the input with the given binding, whose hash
+  /// must be runtime_hash(name), or -1 if not found.
+  [[nodiscard]] int getPos(uint32_t hash, const char* name) const;
   [[nodiscard]] static InputPos getPos(std::vector<InputRoute> const& routes, ConcreteDataMatcher matcher);
   [[nodiscard]] static DataRef getByPos(std::vector<InputRoute> const& routes, InputSpan const& span, int pos, int part = 0);
 
@@ -206,6 +229,17 @@ class InputRecord
     }
     return this->getByPos(pos, part);
   }
+
+  // Given a binding hashed at compile time, return the associated DataRef
+  DataRef getDataRefByHash(uint32_t hash, const char* bindingName, int part = 0) const
+  {
+    int pos = getPos(hash, bindingName);
+    if (pos < 0) {
+      auto msg = describeAvailableInputs();
+      throw runtime_error_f("InputRecord::get: no input with binding %s found. %s", bindingName, msg.c_str());
+    }
+    return this->getByPos(pos, part);
+  }
   /// Get the object of specified type T for the binding R.
   /// If R is a string like object, we look up by name the InputSpec and
   /// return the data associated to the given label.
@@ -231,6 +265,8 @@ class InputRecord
       ref = getDataRefByString(binding.c_str(), part);
     } else if constexpr (std::is_same_v<decayed, DataRef>) {
       ref = binding;
+    } else if constexpr (is_const_str<decayed>::value) {
+      ref = getDataRefByHash(decayed::hash, decayed::str, part);
     } else {
       static_assert(always_static_assert_v<R>, "Unknown binding type");
     }
@@ -402,6 +438,7 @@ class InputRecord
           void* obj = (void*)result.get();
           callbacks.call<CallbackService::Id::CCDBDeserialised>((ConcreteDataMatcher&)matcher, (void*)obj);
           cache.idToObject[id] = obj;
+          cache.objectToId[obj] = id;
           LOGP(info, "Caching in {} ptr to {} ({})", id.value, path, obj);
           return result;
         }
@@ -414,11 +451,14 @@ class InputRecord
         }
         // The id in the cache is different. Let's destroy the old cached entry
         // and create a new one.
+        cache.objectToId.erase(cache.idToObject[oldId]);
         delete reinterpret_cast<ValueT*>(cache.idToObject[oldId]);
+        cache.idToObject.erase(oldId);
         std::unique_ptr<ValueT const, Deleter<ValueT const>> result(DataRefUtils::as<CCDBSerialized<ValueT>>(ref).release(), false);
         void* obj = (void*)result.get();
         callbacks.call<CallbackService::Id::CCDBDeserialised>((ConcreteDataMatcher&)matcher, (void*)obj);
         cache.idToObject[id] = obj;
+        cache.objectToId[obj] = id;
         LOGP(info, "Replacing cached entry {} with {} for {} ({})", oldId.value, id.value, path, obj);
         oldId.value = id.value;
         return result;
@@ -462,6 +502,12 @@ class InputRecord
 
   /// Helper method to be used to check if a given part of the InputRecord is present.
   bool isValid(char const* s) const;
+  template <char... chars>
+  [[nodiscard]] bool isValid(ConstStr<chars...> s) const
+  {
+    int pos = getPos(s.hash, s.str);
+    return pos >= 0 && isValid(pos);
+  }
   [[nodiscard]] bool isValid(int pos) const;
 
   /// @return the total number of inputs in the InputRecord. Notice that these will include
@@ -664,8 +710,13 @@ class InputRecord
   ServiceRegistryRef mRegistry;
   std::vector<InputRoute> const& mInputsSchema;
   InputSpan& mSpan;
+  std::shared_ptr<InputIndex const> mIndex;
 };
 
+/// Use to get an input with a binding hashed at compile time, e.g.
+/// inputs.get<gsl::span<int>>(BINDING("clusters"))
+#define BINDING(name) CONST_STR(name)
+
 } // namespace o2::framework
 
 #endif // O2_FRAMEWORK_INPUTREGISTRY_H_
@@ -57,6 +57,8 @@ class MessageContext
 
   // so far we are only using one instance per named channel
   static constexpr int DefaultChannelIndex = 0;
+  /// Maximum number of objects whose serialized buffer is kept around.
+  static constexpr size_t MaxSerializationCacheEntries = 64;
 
   MessageContext(FairMQDeviceProxy& proxy)
     : mProxy{proxy}
@@ -139,6 +141,14 @@ class MessageContext
       return o2::header::get<o2::framework::DataProcessingHeader*>(mParts.At(0)->GetData());
     }
 
+    void const* payload()
+    {
+      if (mParts.Size() < 2 || mParts.At(1) == nullptr) {
+        return nullptr;
+      }
+      return mParts.At(1)->GetData();
+    }
+
     o2::header::Stack const* headerStack()
     {
       // we would expect this function to be const but the fair::mq::Parts API does not allow this
@@ -466,6 +476,9 @@ class MessageContext
   /// discarded.
   void clear();
 
+  /// @return the payload of the last message created for @a spec, nullptr if none.
+  void const* findMessagePayload(const Output& spec);
+
   FairMQDeviceProxy& proxy()
   {
     return mProxy;
@@ -479,6 +492,18 @@ class MessageContext
   // Prune a message from cache
   void pruneFromCache(int64_t id);
 
+  /// Retrieve a shallow copy of the serialized buffer previously stored for
+  /// the object at @a object, provided its @a type and @a version did not change
+  /// and it was created by @a transport. Returns nullptr otherwise.
+  [[nodiscard]] std::unique_ptr<fair::mq::Message> cloneFromSerializationCache(void const* object, size_t type, uint64_t version,
+                                                                               fair::mq::TransportFactory const* transport);
+  /// Keep a (reference counted) copy of the serialized buffer of the object at
+  /// @a object, replacing any previous version of it. Nothing is kept if
+  /// there are already MaxSerializationCacheEntries objects in the cache.
+  /// Buffers which were not used during a whole timeslice are dropped
+  /// by clear().
+  void addToSerializationCache(void const* object, size_t type, uint64_t version, std::unique_ptr<fair::mq::Message>& message);
+
   /// call the proxy to create a message of the specified size
   /// we don't implement in the header to avoid including the fair::mq::Device header here
   /// that's why the different versions need to be implemented as individual functions
@@ -503,6 +528,16 @@ class MessageContext
   DispatchControl mDispatchControl;
   /// Cached messages, in case we want to reuse them.
   std::unordered_map<int64_t, std::unique_ptr<fair::mq::Message>> mMessageCache;
+  struct SerializationCacheEntry {
+    size_t type;
+    uint64_t version;
+    int64_t cacheId;
+    /// Whether the entry was used since the last clear().
+    bool used;
+  };
+  /// Serialized buffers of objects which are sent multiple times, indexed by
+  /// the address of the original object.
+  std::unordered_map<void const*, SerializationCacheEntry> mSerializationCache;
 };
 } // namespace o2::framework
 #endif // O2_FRAMEWORK_MESSAGECONTEXT_H_
@@ -46,6 +46,9 @@ struct ObjectCache {
   /// A map from a CacheId (which is the void* ptr of the previous map).
   /// to an actual (type erased) pointer to the deserialised object.
   std::unordered_map<Id, void*, Id::hash_fn> idToObject;
+  /// The reverse of the previous map, to find out if a given
+  /// object comes from the cache.
+  std::unordered_map<void const*, Id> objectToId;
 };
 
 } // namespace o2::framework
@@ -20,15 +20,72 @@
 
 namespace o2::framework
 {
+/// Adjusts the number of timeframes allowed in flight (between 1 and
+/// the configured maximum) from the shared memory occupancy and from the
+/// time it takes for the workflow to consume a timeframe: additive
+/// increase while there is no pressure, multiplicative decrease otherwise.
+class AdaptiveRateLimit
+{
+ public:
+  using TimePoint = std::chrono::time_point<std::chrono::system_clock>;
+
+  /// Occupancy above which we back off and below which we can grow again.
+  static constexpr float HighSHMOccupancy = 0.85f;
+  static constexpr float LowSHMOccupancy = 0.6f;
+  /// Latency, relative to the best recent one, above which we back off.
+  static constexpr float MaxLatencyRatio = 2.f;
+  static constexpr float DecreaseFactor = 0.7f;
+  /// The best latency is measured again over windows of this length, so
+  /// that it follows the changes in the processing time of the workflow.
+  static constexpr std::chrono::seconds MinLatencyWindow{30};
+
+  /// Record that timeframe @a tf was published at @a when.
+  void sent(int64_t tf, TimePoint when);
+  /// Record that, at @a when, the workflow is done with all the
+  /// timeframes before @a consumed.
+  void consumed(int64_t consumed, TimePoint when);
+  /// Recompute the limit once @a sentTimeframes were published, given
+  /// the shared memory occupancy @a shmOccupancy (negative if unknown).
+  void update(int maxInFlight, int64_t sentTimeframes, float shmOccupancy);
+
+  [[nodiscard]] float limit() const { return mLimit; }
+  [[nodiscard]] float latency() const { return mLatency; }
+  [[nodiscard]] float minLatency() const { return mMinLatency; }
+
+ private:
+  float mLimit = 0.f;
+  int64_t mLastDecrease = 0;
+  int64_t mSent = 0;
+  int64_t mConsumed = 0;
+  float mLatency = 0.f;
+  float mMinLatency = 0.f;
+  float mWindowMinLatency = 0.f;
+  TimePoint mWindowStart;
+  std::vector<TimePoint> mSendTimes;
+};
+
 class RateLimiter
 {
  public:
   int check(ProcessingContext& ctx, int maxInFlight, size_t minSHM);
 
  private:
+  /// Feed the adaptive limit with the latest consumption feedback and
+  /// shared memory occupancy.
+  void updateAdaptiveLimit(ProcessingContext& ctx, int maxInFlight);
+  /// Account for the newly consumed timeframes, up to @a consumed.
+  void updateConsumed(int64_t consumed);
+
   int64_t mConsumedTimeframes = 0;
   int64_t mSentTimeframes = 0;
 
+  /// State of the adaptive rate limiting
+  AdaptiveRateLimit mAdaptive;
+  /// The free shared memory is only queried every SHMSamplingInterval.
+  static constexpr std::chrono::milliseconds SHMSamplingInterval{100};
+  std::chrono::time_point<std::chrono::system_clock> mLastSHMSample;
+  float mSHMOccupancy = -1.f;
+
   std::vector<std::chrono::time_point<std::chrono::system_clock>> mTfTimes;
   std::chrono::time_point<std::chrono::system_clock> mLastTime, mFirstTime;
   int64_t mTimeCountingSince = 0;
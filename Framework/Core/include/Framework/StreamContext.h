@@ -12,6 +12,7 @@
 #define O2_FRAMEWORK_STREAMCONTEXT_H_
 
 #include "Framework/ServiceHandle.h"
+#include "Framework/DataRelayer.h"
 #include "ProcessingContext.h"
 #include "ServiceSpec.h"
 #include <functional>
@@ -71,6 +72,12 @@ struct StreamContext {
   // basis.
   std::vector<bool> routeDPLCreated;
   std::vector<bool> routeCreated;
+
+  /// Whether or not this stream did something in the current iteration.
+  /// It is copied to the device on the main thread once the stream is done.
+  bool wasActive = false;
+  /// The actions this stream got from the DataRelayer.
+  std::vector<DataRelayer::RecordAction> completed;
 };
 
 } // namespace o2::framework
@@ -988,6 +988,11 @@ o2::framework::ServiceSpec CommonServices::dataProcessingStats()
         MetricSpec{.name = "dropped_computations", .metricId = static_cast<short>(ProcessingStatsId::DROPPED_COMPUTATIONS), .kind = Kind::UInt64, .minPublishInterval = quickUpdateInterval},
         MetricSpec{.name = "dropped_incoming_messages", .metricId = static_cast<short>(ProcessingStatsId::DROPPED_INCOMING_MESSAGES), .kind = Kind::UInt64, .minPublishInterval = quickUpdateInterval},
         MetricSpec{.name = "relayed_messages", .metricId = static_cast<short>(ProcessingStatsId::RELAYED_MESSAGES), .kind = Kind::UInt64, .minPublishInterval = quickUpdateInterval},
+        MetricSpec{.name = "output_messages_created", .metricId = static_cast<short>(ProcessingStatsId::OUTPUT_MESSAGES_CREATED), .kind = Kind::UInt64, .minPublishInterval = quickUpdateInterval},
+        MetricSpec{.name = "output_messages_pooled", .metricId = static_cast<short>(ProcessingStatsId::OUTPUT_MESSAGES_POOLED), .kind = Kind::UInt64, .minPublishInterval = quickUpdateInterval},
+        MetricSpec{.name = "rate_limit_tfs_in_flight", .metricId = static_cast<short>(ProcessingStatsId::RATE_LIMIT_TFS_IN_FLIGHT), .kind = Kind::UInt64, .minPublishInterval = quickUpdateInterval},
+        MetricSpec{.name = "rate_limit_shm_occupancy_permille", .metricId = static_cast<short>(ProcessingStatsId::RATE_LIMIT_SHM_OCCUPANCY), .kind = Kind::Int, .minPublishInterval = quickUpdateInterval},
+        MetricSpec{.name = "rate_limit_latency_ms", .metricId = static_cast<short>(ProcessingStatsId::RATE_LIMIT_LATENCY_MS), .kind = Kind::UInt64, .minPublishInterval = quickUpdateInterval},
         MetricSpec{.name = "arrow-bytes-destroyed",
                    .enabled = arrowAndResourceLimitingMetrics,
                    .metricId = static_cast<short>(ProcessingStatsId::ARROW_BYTES_DESTROYED),
@@ -1078,7 +1083,11 @@ o2::framework::ServiceSpec CommonServices::dataProcessingStats()
     .configure = noConfiguration(),
     .postProcessing = [](ProcessingContext& context, void* service) {
       auto* stats = (DataProcessingStats*)service;
-      stats->updateStats({(short)ProcessingStatsId::PERFORMED_COMPUTATIONS, DataProcessingStats::Op::Add, 1}); },
+      stats->updateStats({(short)ProcessingStatsId::PERFORMED_COMPUTATIONS, DataProcessingStats::Op::Add, 1});
+      // Number of output messages allocated by this computation, i.e. per timeframe.
+      auto [created, pooled] = context.services().get<FairMQDeviceProxy>().consumeOutputMessagesCount();
+      stats->updateStats({(short)ProcessingStatsId::OUTPUT_MESSAGES_CREATED, DataProcessingStats::Op::Set, created});
+      stats->updateStats({(short)ProcessingStatsId::OUTPUT_MESSAGES_POOLED, DataProcessingStats::Op::Set, pooled}); },
     .preDangling = [](DanglingContext& context, void* service) {
        auto* stats = (DataProcessingStats*)service;
        sendRelayerMetrics(context.services(), *stats);
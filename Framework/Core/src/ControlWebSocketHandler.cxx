@@ -40,6 +40,18 @@ void ControlWebSocketHandler::frame(char const* frame, size_t s)
     }
     return false;
   };
+  if (DeviceMetricsHelper::isBinaryMetric(frame, s)) {
+    // Fast path: the metric was already registered, no parsing needed.
+    BinaryMetric metric;
+    memcpy(&metric, frame, sizeof(metric));
+    if (metric.id >= mBinaryMetricIndices.size() || mBinaryMetricIndices[metric.id] == (size_t)-1) {
+      LOG(error) << "Binary metric with unknown id " << metric.id;
+      return;
+    }
+    assert(mContext.metrics);
+    didProcessMetric |= DeviceMetricsHelper::processBinaryMetric(metric, mBinaryMetricIndices[metric.id], (*mContext.metrics)[mIndex]);
+    return;
+  }
   LOG(debug3) << "Data received: " << std::string_view(frame, s);
   if (DeviceMetricsHelper::parseMetric(tokenSV, metricMatch)) {
     // We use this callback to cache which metrics are needed to provide a
@@ -51,6 +63,24 @@ void ControlWebSocketHandler::frame(char const* frame, size_t s)
     return;
   }
 
+  uint32_t metricId;
+  std::string_view metricName;
+  if (DeviceMetricsHelper::parseMetricId(tokenSV, metricId, metricName)) {
+    // The metric was just created by its first textual update,
+    // so we only need to remember where it is.
+    assert(mContext.metrics);
+    auto metricIndex = DeviceMetricsHelper::metricIdxByName(std::string(metricName), (*mContext.metrics)[mIndex]);
+    if (metricIndex == (*mContext.metrics)[mIndex].metrics.size()) {
+      LOG(error) << "Registration of unknown metric " << metricName;
+      return;
+    }
+    if (metricId >= mBinaryMetricIndices.size()) {
+      mBinaryMetricIndices.resize(metricId + 1, (size_t)-1);
+    }
+    mBinaryMetricIndices[metricId] = metricIndex;
+    return;
+  }
+
   ParsedConfigMatch configMatch;
   std::string_view const token(frame, s);
   std::match_results<std::string_view::const_iterator> match;
@@ -14,6 +14,7 @@
 #include "ControlServiceHelpers.h"
 #include <map>
 #include <string>
+#include <vector>
 
 namespace o2::framework
 {
@@ -70,6 +71,9 @@ struct ControlWebSocketHandler : public WebSocketHandler {
   /// actually processed some metric.
   bool didProcessMetric = false;
   bool didHaveNewMetric = false;
+  /// Position in the DeviceMetricsInfo of the metrics which the device
+  /// sends as BinaryMetric, indexed by the id it registered for them.
+  std::vector<size_t> mBinaryMetricIndices;
 };
 
 } // namespace o2::framework
@@ -11,6 +11,7 @@
 
 #include "DPLMonitoringBackend.h"
 #include "Framework/DriverClient.h"
+#include "Framework/DeviceMetricsInfo.h"
 #include "Framework/ServiceRegistry.h"
 #include "Framework/RuntimeError.h"
 #include <fmt/format.h>
@@ -53,6 +54,48 @@ inline unsigned long convertTimestamp(const std::chrono::time_point<std::chrono:
 }
 
 void DPLMonitoringBackend::send(o2::monitoring::Metric const& metric)
+{
+  // Only single numeric values can go through the binary path.
+  BinaryMetric binary;
+  if (metric.getValuesSize() != 1) {
+    sendText(metric);
+    return;
+  }
+  auto const& value = metric.getValues().front().second;
+  if (auto const* v = std::get_if<int>(&value)) {
+    binary.type = MetricType::Int;
+    binary.intValue = *v;
+  } else if (auto const* v = std::get_if<double>(&value)) {
+    binary.type = MetricType::Float;
+    binary.floatValue = *v;
+  } else if (auto const* v = std::get_if<uint64_t>(&value)) {
+    binary.type = MetricType::Uint64;
+    binary.uint64Value = *v;
+  } else {
+    sendText(metric);
+    return;
+  }
+
+  {
+    // The lock is kept while registering, so that no other thread can send
+    // the binary version of the metric before the driver knows about its id.
+    std::lock_guard<std::mutex> lock(mMetricIdsMutex);
+    auto [it, inserted] = mMetricIds.try_emplace(metric.getName(), (uint32_t)mMetricIds.size());
+    binary.id = it->second;
+    if (inserted) {
+      // The first update goes through the text path so that the driver
+      // creates the metric exactly as before, then we associate the id to it.
+      sendText(metric);
+      auto registration = fmt::format("[METRIC_ID] {} {}", binary.id, metric.getName());
+      mRegistry.get<framework::DriverClient>().tell(registration.data(), registration.size());
+      return;
+    }
+  }
+  binary.timestamp = convertTimestamp(metric.getTimestamp());
+  mRegistry.get<framework::DriverClient>().tell(reinterpret_cast<char const*>(&binary), sizeof(binary));
+}
+
+void DPLMonitoringBackend::sendText(o2::monitoring::Metric const& metric)
 {
   std::array<char, 4096> buffer;
   auto mStream = fmt::format_to(buffer.begin(), "[METRIC] {}", metric.getName());
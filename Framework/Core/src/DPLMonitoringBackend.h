@@ -13,7 +13,9 @@
 
 #include "Framework/ServiceRegistryRef.h"
 #include "Monitoring/Backend.h"
+#include <mutex>
 #include <string>
+#include <unordered_map>
 
 namespace o2::framework
 {
@@ -30,7 +32,8 @@ class DPLMonitoringBackend final : public o2::monitoring::Backend
   /// Default destructor
   ~DPLMonitoringBackend() override = default;
 
-  /// Prints metric
+  /// Sends metric to the driver. Single numeric values are sent as a
+  /// BinaryMetric once the driver knows about them, everything else as text.
   /// \param metric           reference to metric object
   void send(const o2::monitoring::Metric& metric) override;
 
@@ -44,9 +47,14 @@ class DPLMonitoringBackend final : public o2::monitoring::Backend
   void addGlobalTag(std::string_view name, std::string_view value) override;
 
  private:
+  /// Sends the metric in its textual form
+  void sendText(const o2::monitoring::Metric& metric);
+
   std::string mTagString;    ///< Global tagset (common for each metric)
   const std::string mPrefix; ///< Metric prefix
   ServiceRegistryRef mRegistry;
+  std::unordered_map<std::string, uint32_t> mMetricIds; ///< Ids of the metrics sent in binary form
+  std::mutex mMetricIdsMutex;
 };
 
 } // namespace o2::framework
@@ -19,6 +19,7 @@
 #include "Framework/FairMQResizableBuffer.h"
 #include "Framework/DataProcessingContext.h"
 #include "Framework/DeviceSpec.h"
+#include "Framework/ObjectCache.h"
 #include "Framework/StreamContext.h"
 #include "Framework/Signpost.h"
 #include "Headers/DataHeader.h"
@@ -355,6 +356,31 @@ void DataAllocator::adoptFromCache(const Output& spec, CacheId id, header::Seria
   context.add<MessageContext::TrivialObject>(std::move(headerMessage), std::move(payloadMessage), routeIndex);
 }
 
+bool DataAllocator::adoptFromSerializationCache(Output const& spec, RouteIndex routeIndex, void const* object, size_t type, SerializationVersion& version)
+{
+  if (version.value == 0) {
+    if (!mRegistry.active<ObjectCache>()) {
+      return false;
+    }
+    // Objects deserialised from the CCDB are immutable and only replaced
+    // when a new blob arrives, so the id of the blob is a good version.
+    auto& cache = mRegistry.get<ObjectCache>();
+    auto cached = cache.objectToId.find(object);
+    if (cached == cache.objectToId.end()) {
+      return false;
+    }
+    version.value = cached->second.value;
+  }
+  auto& context = mRegistry.get<MessageContext>();
+  auto* transport = context.proxy().getOutputTransport(routeIndex);
+  auto payloadMessage = context.cloneFromSerializationCache(object, type, version.value, transport);
+  if (!payloadMessage) {
+    return false;
+  }
+  addPartToContext(routeIndex, std::move(payloadMessage), spec, header::gSerializationMethodROOT);
+  return true;
+}
+
 void DataAllocator::cookDeadBeef(const Output& spec)
 {
   auto& proxy = mRegistry.get<FairMQDeviceProxy>();
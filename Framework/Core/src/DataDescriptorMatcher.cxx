@@ -13,6 +13,7 @@
 #include "Framework/DataDescriptorMatcher.h"
 #include "Framework/DataMatcherWalker.h"
 #include "Framework/DataProcessingHeader.h"
+#include "Framework/DataSpecUtils.h"
 #include "Framework/VariantHelpers.h"
 #include "Framework/RuntimeError.h"
 #include "Headers/DataHeader.h"
@@ -521,4 +522,13 @@ std::ostream& operator<<(std::ostream& os, DataDescriptorMatcher::Op const& op)
   return os;
 }
 
+void DataDescriptorMatcherIndex::add(int pos, DataDescriptorMatcher const& matcher)
+{
+  if (auto concrete = DataSpecUtils::optionalConcreteDataMatcherFrom(matcher)) {
+    mExact[*concrete].push_back(pos);
+  } else {
+    mWildcards.push_back(pos);
+  }
+}
+
 } // namespace o2::framework::data_matcher
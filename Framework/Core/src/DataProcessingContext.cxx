@@ -15,6 +15,8 @@
 #include "Framework/TimingInfo.h"
 #include "Framework/Signpost.h"
 
+#include <mutex>
+
 O2_DECLARE_DYNAMIC_LOG(data_processor_context);
 O2_DECLARE_DYNAMIC_LOG(calibration);
 
@@ -23,6 +25,10 @@ namespace o2::framework
 
 namespace
 {
+/// Callbacks of services which are not declared to be thread safe (i.e. of
+/// kind Serial) must not be invoked concurrently by different streams.
+std::recursive_mutex serialCallbacksMutex;
+
 template <typename T, typename... ARGS>
 void invokeAll(T& handles, char const* callbackName, o2::framework::DataProcessorSpec* spec, ARGS&... args)
 {
@@ -35,7 +41,12 @@ void invokeAll(T& handles, char const* callbackName, o2::framework::DataProcesso
   for (auto& handle : handles) {
     O2_SIGNPOST_ID_FROM_POINTER(cid, data_processor_context, handle.service);
     O2_SIGNPOST_START(data_processor_context, cid, "callbacks", "Starting %{public}s::%{public}s::%{public}s", dataProcessorName, handle.spec.name.c_str(), callbackName);
-    handle.callback(args..., handle.service);
+    if (handle.spec.kind == ServiceKind::DataProcessorSerial || handle.spec.kind == ServiceKind::DeviceSerial) {
+      std::scoped_lock<std::recursive_mutex> lock(serialCallbacksMutex);
+      handle.callback(args..., handle.service);
+    } else {
+      handle.callback(args..., handle.service);
+    }
     O2_SIGNPOST_END(data_processor_context, cid, "callbacks", "Ending %{public}s::%{public}s::%{public}s", dataProcessorName, handle.spec.name.c_str(), callbackName);
   }
   O2_SIGNPOST_END(data_processor_context, dpid, "callbacks", "Ending %{public}s::%{public}s", dataProcessorName, callbackName);
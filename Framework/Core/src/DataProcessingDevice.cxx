@@ -74,6 +74,7 @@
 #include <vector>
 #include <numeric>
 #include <memory>
+#include <mutex>
 #include <unordered_map>
 #include <uv.h>
 #include <execinfo.h>
@@ -246,11 +247,76 @@ void run_callback(uv_work_t* handle)
   auto& dataProcessorContext = ref.get<DataProcessorContext>();
   O2_SIGNPOST_ID_FROM_POINTER(sid, device, &dataProcessorContext);
   O2_SIGNPOST_START(device, sid, "run_callback", "Starting run callback on stream %d", task->id.index);
-  DataProcessingDevice::doPrepare(ref);
+  {
+    // Receiving from the channels is not thread safe, so only one stream at
+    // the time can do it. The actual processing happens concurrently.
+    static std::mutex prepareMutex;
+    std::scoped_lock<std::mutex> lock(prepareMutex);
+    DataProcessingDevice::doPrepare(ref);
+  }
   DataProcessingDevice::doRun(ref);
   O2_SIGNPOST_END(device, sid, "run_callback", "Done processing data for stream %d", task->id.index);
 }
 
+namespace
+{
+/// Makes sure that the outputs of concurrent streams are sent in the same
+/// order in which their computations started. The ticket is released when
+/// going out of scope, so that an exception does not block the other streams.
+struct OutputOrderingTicket {
+  OutputOrderingTicket(DataProcessorContext& context)
+    : mContext{context},
+      mEnabled{context.orderedOutputs}
+  {
+  }
+
+  ~OutputOrderingTicket()
+  {
+    release();
+  }
+
+  /// Take the next ticket. This is separate from the construction so that
+  /// it can happen under a lock which is released before the ticket is.
+  void take()
+  {
+    if (mEnabled) {
+      mTicket = mContext.nextOutputTicket.fetch_add(1);
+      mTaken = true;
+    }
+  }
+
+  /// Block until all the computations which started before this one sent their outputs.
+  void wait()
+  {
+    if (!mTaken) {
+      return;
+    }
+    std::unique_lock<std::mutex> lock(mContext.outputOrderMutex);
+    mContext.outputOrderCondition.wait(lock, [this]() { return mContext.nextOutputToSend == mTicket; });
+  }
+
+  void release()
+  {
+    if (!mTaken || mReleased) {
+      return;
+    }
+    wait();
+    {
+      std::scoped_lock<std::mutex> lock(mContext.outputOrderMutex);
+      mContext.nextOutputToSend++;
+      mReleased = true;
+    }
+    mContext.outputOrderCondition.notify_all();
+  }
+
+  DataProcessorContext& mContext;
+  bool mEnabled;
+  bool mTaken = false;
+  bool mReleased = false;
+  uint64_t mTicket = 0;
+};
+} // namespace
+
 // Once the processing in a thread is done, this is executed on the main thread.
 void run_completion(uv_work_t* handle, int status)
 {
@@ -260,6 +326,9 @@ void run_completion(uv_work_t* handle, int status)
   auto ref = ServiceRegistryRef{*task->registry, ServiceRegistry::globalStreamSalt(task->id.index + 1)};
   auto& state = ref.get<DeviceState>();
   auto& quotaEvaluator = ref.get<ComputingQuotaEvaluator>();
+  // Only the main thread touches the activity of the device.
+  auto& dpContext = ref.get<DataProcessorContext>();
+  *dpContext.wasActive = ref.get<StreamContext>().wasActive;
 
   using o2::monitoring::Metric;
   using o2::monitoring::Monitoring;
@@ -400,6 +469,7 @@ void DataProcessingDevice::Init()
   context.statefulProcess = nullptr;
   context.error = spec.algorithm.onError;
   context.initError = spec.algorithm.onInitError;
+  context.inputIndex = InputRecord::buildIndex(spec.inputs);
 
   auto configStore = DeviceConfigurationHelpers::getConfiguration(mServiceRegistry, spec.name.c_str(), spec.options);
   if (configStore == nullptr) {
@@ -513,6 +583,21 @@ void DataProcessingDevice::Init()
     spec.callbacksPolicy.policy(mServiceRegistry.get<CallbackService>(ServiceRegistry::globalDeviceSalt()), initContext);
   }
 
+  // Number of streams processing timeslices concurrently. The processing
+  // callback must be reentrant for this to work, so it is an explicit
+  // opt-in of a given data processor, which declares the "dpl-streams" option.
+  int nStreams = 1;
+  if (mConfigRegistry->hasOption("dpl-streams")) {
+    nStreams = std::max(1, mConfigRegistry->get<int>("dpl-streams"));
+  }
+  if (nStreams > 1) {
+    O2_SIGNPOST_EVENT_EMIT_INFO(device, cid, "Init", "Processing timeslices on %d concurrent streams.", nStreams);
+  }
+  mStreams.resize(nStreams);
+  mHandles.resize(nStreams);
+  context.orderedOutputs = nStreams > 1;
+  mServiceRegistry.get<DataRelayer>(ServiceRegistry::globalDeviceSalt()).setClaimSlots(nStreams > 1);
+
   // Services which are stream should be initialised now
   auto* options = GetConfig();
   for (size_t si = 0; si < mStreams.size(); ++si) {
@@ -1275,9 +1360,11 @@ void DataProcessingDevice::Run()
   O2_SIGNPOST_ID_FROM_POINTER(lid, device, state.loop);
   O2_SIGNPOST_START(device, lid, "device_state", "First iteration of the device loop");
 
-  bool dplEnableMultithreding = getenv("DPL_THREADPOOL_SIZE") != nullptr;
+  bool dplEnableMultithreding = getenv("DPL_THREADPOOL_SIZE") != nullptr || mStreams.size() > 1;
   if (dplEnableMultithreding) {
-    setenv("UV_THREADPOOL_SIZE", "1", 1);
+    // One worker thread per stream. This needs to happen before
+    // the first work is queued, when libuv creates its thread pool.
+    setenv("UV_THREADPOOL_SIZE", std::to_string(mStreams.size()).c_str(), 1);
   }
 
   while (state.transitionHandling != TransitionHandlingState::Expired) {
@@ -1500,7 +1587,8 @@ void DataProcessingDevice::doPrepare(ServiceRegistryRef ref)
   O2_SIGNPOST_ID_FROM_POINTER(dpid, device, &context);
   O2_SIGNPOST_START(device, dpid, "do_prepare", "Starting DataProcessorContext::doPrepare.");
 
-  *context.wasActive = false;
+  auto& streamContext = ref.get<StreamContext>();
+  streamContext.wasActive = false;
   {
     ref.get<CallbackService>().call<CallbackService::Id::ClockTick>();
   }
@@ -1659,7 +1747,7 @@ void DataProcessingDevice::doPrepare(ServiceRegistryRef ref)
     socket.Events(&info.hasPendingEvents);
     if (info.hasPendingEvents) {
       info.readPolled = false;
-      *context.wasActive |= newMessages;
+      streamContext.wasActive |= newMessages;
     }
     O2_SIGNPOST_END(device, cid, "channels", "Done processing channel %{public}s (%d).",
                     channelSpec.name.c_str(), info.id.value);
@@ -1681,26 +1769,31 @@ void DataProcessingDevice::doRun(ServiceRegistryRef ref)
   };
   auto& state = ref.get<DeviceState>();
   auto& spec = ref.get<DeviceSpec const>();
+  auto& streamContext = ref.get<StreamContext>();
 
   if (state.streaming == StreamingState::Idle) {
-    *context.wasActive = false;
+    streamContext.wasActive = false;
     return;
   }
 
-  context.completed.clear();
-  context.completed.reserve(16);
-  *context.wasActive |= DataProcessingDevice::tryDispatchComputation(ref, context.completed);
+  streamContext.completed.clear();
+  streamContext.completed.reserve(16);
+  streamContext.wasActive |= DataProcessingDevice::tryDispatchComputation(ref, streamContext.completed);
+
+  // The processing of the ready timeslices above can happen concurrently
+  // on all the streams, what follows changes the state of the whole device.
+  std::scoped_lock<std::recursive_mutex> stateLock(context.streamingStateMutex);
   DanglingContext danglingContext{*context.registry};
 
   context.preDanglingCallbacks(danglingContext);
-  if (*context.wasActive == false) {
+  if (streamContext.wasActive == false) {
     ref.get<CallbackService>().call<CallbackService::Id::Idle>();
   }
   auto activity = ref.get<DataRelayer>().processDanglingInputs(context.expirationHandlers, *context.registry, true);
-  *context.wasActive |= activity.expiredSlots > 0;
+  streamContext.wasActive |= activity.expiredSlots > 0;
 
-  context.completed.clear();
-  *context.wasActive |= DataProcessingDevice::tryDispatchComputation(ref, context.completed);
+  streamContext.completed.clear();
+  streamContext.wasActive |= DataProcessingDevice::tryDispatchComputation(ref, streamContext.completed);
 
   context.postDanglingCallbacks(danglingContext);
 
@@ -1710,7 +1803,7 @@ void DataProcessingDevice::doRun(ServiceRegistryRef ref)
   // framework itself.
   if (context.allDone == true && state.streaming == StreamingState::Streaming) {
     switchState(StreamingState::EndOfStreaming);
-    *context.wasActive = true;
+    streamContext.wasActive = true;
   }
 
   if (state.streaming == StreamingState::EndOfStreaming) {
@@ -1724,7 +1817,7 @@ void DataProcessingDevice::doRun(ServiceRegistryRef ref)
 
     bool shouldProcess = hasOnlyGenerated(spec) == false;
 
-    while (DataProcessingDevice::tryDispatchComputation(ref, context.completed) && shouldProcess) {
+    while (DataProcessingDevice::tryDispatchComputation(ref, streamContext.completed) && shouldProcess) {
       relayer.processDanglingInputs(context.expirationHandlers, *context.registry, false);
     }
 
@@ -1743,20 +1836,27 @@ void DataProcessingDevice::doRun(ServiceRegistryRef ref)
     EndOfStreamContext eosContext{*context.registry, ref.get<DataAllocator>()};
 
     context.preEOSCallbacks(eosContext);
-    auto& streamContext = ref.get<StreamContext>();
     streamContext.preEOSCallbacks(eosContext);
     ref.get<CallbackService>().call<CallbackService::Id::EndOfStream>(eosContext);
     streamContext.postEOSCallbacks(eosContext);
     context.postEOSCallbacks(eosContext);
 
-    for (auto& channel : spec.outputChannels) {
-      O2_SIGNPOST_EVENT_EMIT(device, dpid, "state", "Sending end of stream to %{public}s.", channel.name.c_str());
-      DataProcessingHelpers::sendEndOfStream(ref, channel);
+    {
+      // The end of stream must follow the outputs of the computations
+      // which are still running on the other streams.
+      OutputOrderingTicket eosTicket{context};
+      eosTicket.take();
+      eosTicket.wait();
+      std::scoped_lock<std::mutex> sendLock(context.sendMutex);
+      for (auto& channel : spec.outputChannels) {
+        O2_SIGNPOST_EVENT_EMIT(device, dpid, "state", "Sending end of stream to %{public}s.", channel.name.c_str());
+        DataProcessingHelpers::sendEndOfStream(ref, channel);
+      }
     }
     // This is needed because the transport is deleted before the device.
     relayer.clear();
     switchState(StreamingState::Idle);
-    *context.wasActive = shouldProcess;
+    streamContext.wasActive = shouldProcess;
     // On end of stream we shut down all output pollers.
     O2_SIGNPOST_EVENT_EMIT(device, dpid, "state", "Shutting down output pollers.");
     for (auto& poller : state.activeOutputPollers) {
@@ -1811,6 +1911,7 @@ void DataProcessingDevice::handleData(ServiceRegistryRef ref, InputChannelInfo&
   using InputType = DataRelayer::InputType;
 
   auto& context = ref.get<DataProcessorContext>();
+  auto& streamContext = ref.get<StreamContext>();
   // This is the same id as the upper level function, so we get the events
   // associated with the same interval. We will simply use "handle_data" as
   // the category.
@@ -1820,7 +1921,7 @@ void DataProcessingDevice::handleData(ServiceRegistryRef ref, InputChannelInfo&
   // and we do a few stats. We bind parts as a lambda captured variable, rather
   // than an input, because we do not want the outer loop actually be exposed
   // to the implementation details of the messaging layer.
-  auto getInputTypes = [&info, &context]() -> std::optional<std::vector<InputInfo>> {
+  auto getInputTypes = [&info, &context, &streamContext]() -> std::optional<std::vector<InputInfo>> {
     O2_SIGNPOST_ID_FROM_POINTER(cid, device, &info);
     auto ref = ServiceRegistryRef{*context.registry};
     auto& stats = ref.get<DataProcessingStats>();
@@ -1846,14 +1947,14 @@ void DataProcessingDevice::handleData(ServiceRegistryRef ref, InputChannelInfo&
         O2_SIGNPOST_EVENT_EMIT(device, cid, "handle_data", "Got SourceInfoHeader with state %d", (int)sih->state);
         info.state = sih->state;
         insertInputInfo(pi, 2, InputType::SourceInfo, info.id);
-        *context.wasActive = true;
+        streamContext.wasActive = true;
         continue;
       }
       auto dih = o2::header::get<DomainInfoHeader*>(headerData);
       if (dih) {
         O2_SIGNPOST_EVENT_EMIT(device, cid, "handle_data", "Got DomainInfoHeader with oldestPossibleTimeslice %d", (int)dih->oldestPossibleTimeslice);
         insertInputInfo(pi, 2, InputType::DomainInfo, info.id);
-        *context.wasActive = true;
+        streamContext.wasActive = true;
         continue;
       }
       auto dh = o2::header::get<DataHeader*>(headerData);
@@ -1913,7 +2014,7 @@ void DataProcessingDevice::handleData(ServiceRegistryRef ref, InputChannelInfo&
     stats.updateStats({(int)ProcessingStatsId::ERROR_COUNT, DataProcessingStats::Op::Add, 1});
   };
 
-  auto handleValidMessages = [&info, ref, &reportError](std::vector<InputInfo> const& inputInfos) {
+  auto handleValidMessages = [&info, ref, &reportError, &streamContext](std::vector<InputInfo> const& inputInfos) {
     auto& relayer = ref.get<DataRelayer>();
     static WaitBackpressurePolicy policy;
     auto& parts = info.parts;
@@ -2001,8 +2102,7 @@ void DataProcessingDevice::handleData(ServiceRegistryRef ref, InputChannelInfo&
         } break;
         case InputType::SourceInfo: {
           LOGP(detail, "Received SourceInfo");
-          auto& context = ref.get<DataProcessorContext>();
-          *context.wasActive = true;
+          streamContext.wasActive = true;
           auto headerIndex = input.position;
           auto payloadIndex = input.position + 1;
           assert(payloadIndex < parts.Size());
@@ -2019,8 +2119,7 @@ void DataProcessingDevice::handleData(ServiceRegistryRef ref, InputChannelInfo&
         case InputType::DomainInfo: {
           /// We have back pressure, therefore we do not process DomainInfo anymore.
           /// until the previous message are processed.
-          auto& context = ref.get<DataProcessorContext>();
-          *context.wasActive = true;
+          streamContext.wasActive = true;
           auto headerIndex = input.position;
           auto payloadIndex = input.position + 1;
           assert(payloadIndex < parts.Size());
@@ -2048,7 +2147,7 @@ void DataProcessingDevice::handleData(ServiceRegistryRef ref, InputChannelInfo&
       auto& context = ref.get<DataProcessorContext>();
       context.domainInfoUpdatedCallback(*context.registry, oldestPossibleTimeslice, info.id);
       ref.get<CallbackService>().call<CallbackService::Id::DomainInfoUpdated>((ServiceRegistryRef)*context.registry, (size_t)oldestPossibleTimeslice, (ChannelIndex)info.id);
-      *context.wasActive = true;
+      streamContext.wasActive = true;
     }
     auto it = std::remove_if(parts.fParts.begin(), parts.fParts.end(), [](auto& msg) -> bool { return msg.get() == nullptr; });
     parts.fParts.erase(it, parts.end());
@@ -2364,7 +2463,8 @@ bool DataProcessingDevice::tryDispatchComputation(ServiceRegistryRef ref, std::v
     auto& spec = ref.get<DeviceSpec const>();
     InputRecord record{spec.inputs,
                        span,
-                       *context.registry};
+                       *context.registry,
+                       dpContext.inputIndex};
     ProcessingContext processContext{record, ref, ref.get<DataAllocator>()};
     {
       // Notice this should be thread safe and reentrant
@@ -2372,11 +2472,19 @@ bool DataProcessingDevice::tryDispatchComputation(ServiceRegistryRef ref, std::v
       streamContext.preProcessingCallbacks(processContext);
       dpContext.preProcessingCallbacks(processContext);
     }
+    // With concurrent streams, the ticket decides the order in which the
+    // computations send. Taking it while holding the send lock makes sure
+    // that inputs forwarded early leave in the same order.
+    OutputOrderingTicket outputTicket{dpContext};
+    std::unique_lock<std::mutex> sendLock(dpContext.sendMutex);
+    outputTicket.take();
     if (action.op == CompletionPolicy::CompletionOp::Discard) {
       context.postDispatchingCallbacks(processContext);
       if (spec.forwards.empty() == false) {
         auto& timesliceIndex = ref.get<TimesliceIndex>();
         forwardInputs(ref, action.slot, currentSetOfInputs, timesliceIndex.getOldestPossibleOutput(), false);
+        sendLock.unlock();
+        relayer.releaseSlot(action.slot);
         O2_SIGNPOST_END(device, aid, "device", "Forwarding inputs consume: %d.", false);
         continue;
       }
@@ -2393,6 +2501,7 @@ bool DataProcessingDevice::tryDispatchComputation(ServiceRegistryRef ref, std::v
       auto& timesliceIndex = ref.get<TimesliceIndex>();
       forwardInputs(ref, action.slot, currentSetOfInputs, timesliceIndex.getOldestPossibleOutput(), true, action.op == CompletionPolicy::CompletionOp::Consume);
     }
+    sendLock.unlock();
     markInputsAsDone(action.slot);
 
     uint64_t tStart = uv_hrtime();
@@ -2401,7 +2510,8 @@ bool DataProcessingDevice::tryDispatchComputation(ServiceRegistryRef ref, std::v
 
     static bool noCatch = getenv("O2_NO_CATCHALL_EXCEPTIONS") && strcmp(getenv("O2_NO_CATCHALL_EXCEPTIONS"), "0");
 
-    auto runNoCatch = [&context, ref, &processContext](DataRelayer::RecordAction& action) mutable {
+    bool forwardLate = (context.canForwardEarly == false) && hasForwards && consumeSomething;
+    auto runNoCatch = [&context, ref, &processContext, &outputTicket, forwardLate](DataRelayer::RecordAction& action) mutable {
       auto& state = ref.get<DeviceState>();
       auto& spec = ref.get<DeviceSpec const>();
       auto& streamContext = ref.get<StreamContext>();
@@ -2468,9 +2578,18 @@ bool DataProcessingDevice::tryDispatchComputation(ServiceRegistryRef ref, std::v
         }
 
         {
-          ref.get<CallbackService>().call<CallbackService::Id::PostProcessing>(o2::framework::ServiceRegistryRef{ref}, (int)action.op);
-          dpContext.postProcessingCallbacks(processContext);
-          streamContext.postProcessingCallbacks(processContext);
+          // Outputs are sent by the post processing callbacks.
+          outputTicket.wait();
+          {
+            std::scoped_lock<std::mutex> sendLock(dpContext.sendMutex);
+            ref.get<CallbackService>().call<CallbackService::Id::PostProcessing>(o2::framework::ServiceRegistryRef{ref}, (int)action.op);
+            dpContext.postProcessingCallbacks(processContext);
+            streamContext.postProcessingCallbacks(processContext);
+          }
+          // The inputs forwarded late keep the ticket until they are sent.
+          if (forwardLate == false) {
+            outputTicket.release();
+          }
         }
       }
     };
@@ -2511,22 +2630,33 @@ bool DataProcessingDevice::tryDispatchComputation(ServiceRegistryRef ref, std::v
       context.postDispatchingCallbacks(processContext);
       ref.get<CallbackService>().call<CallbackService::Id::DataConsumed>(o2::framework::ServiceRegistryRef{ref});
     }
-    if ((context.canForwardEarly == false) && hasForwards && consumeSomething) {
+    if (forwardLate) {
       O2_SIGNPOST_EVENT_EMIT(device, aid, "device", "Late forwarding");
+      // Late forwarding happens in the order of the tickets, like the outputs.
+      outputTicket.wait();
+      std::scoped_lock<std::mutex> sendLock(dpContext.sendMutex);
       auto& timesliceIndex = ref.get<TimesliceIndex>();
       forwardInputs(ref, action.slot, currentSetOfInputs, timesliceIndex.getOldestPossibleOutput(), false, action.op == CompletionPolicy::CompletionOp::Consume);
     }
+    outputTicket.release();
     context.postForwardingCallbacks(processContext);
     if (action.op == CompletionPolicy::CompletionOp::Process) {
       cleanTimers(action.slot, record);
     }
+    relayer.releaseSlot(action.slot);
     O2_SIGNPOST_END(device, aid, "device", "Done processing action on slot %lu for action %{public}s", action.slot.index, fmt::format("{}", action.op).c_str());
   }
   O2_SIGNPOST_END(device, sid, "device", "Start processing ready actions");
 
-  // We now broadcast the end of stream if it was requested
+  // We now broadcast the end of stream if it was requested. Only one
+  // stream can do it, after the computations still running on the others.
+  std::scoped_lock<std::recursive_mutex> stateLock(dpContext.streamingStateMutex);
   if (state.streaming == StreamingState::EndOfStreaming) {
     LOGP(detail, "Broadcasting end of stream");
+    OutputOrderingTicket eosTicket{dpContext};
+    eosTicket.take();
+    eosTicket.wait();
+    std::scoped_lock<std::mutex> sendLock(dpContext.sendMutex);
     for (auto& channel : spec.outputChannels) {
       DataProcessingHelpers::sendEndOfStream(ref, channel);
     }
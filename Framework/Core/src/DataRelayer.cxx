@@ -46,6 +46,7 @@
 #include <fmt/format.h>
 #include <fmt/ostream.h>
 #include <gsl/span>
+#include <algorithm>
 #include <numeric>
 #include <string>
 
@@ -89,6 +90,7 @@ DataRelayer::DataRelayer(const CompletionPolicy& policy,
     char buffer[128];
     assert(mDistinctRoutesIndex[i] < routes.size());
     mInputs.push_back(routes[mDistinctRoutesIndex[i]].matcher);
+    mInputMatchersIndex.add(i, mInputMatchers[mDistinctRoutesIndex[i]]);
     auto& matcher = routes[mDistinctRoutesIndex[i]].matcher;
     DataSpecUtils::describe(buffer, 127, matcher);
     queries += std::string_view(buffer, strlen(buffer));
@@ -238,8 +240,24 @@ DataRelayer::ActivityStats DataRelayer::processDanglingInputs(std::vector<Expira
 size_t matchToContext(void const* data,
                       std::vector<DataDescriptorMatcher> const& matchers,
                       std::vector<size_t> const& index,
+                      DataDescriptorMatcherIndex const& lookup,
                       VariableContext& context)
 {
+  // Only try the routes which can possibly match the header.
+  if (auto* dh = o2::header::get<DataHeader*>(data)) {
+    int ri = lookup.find(*dh, [&](int ri) {
+      if (matchers[index[ri]].match(reinterpret_cast<char const*>(data), context)) {
+        return true;
+      }
+      context.discard();
+      return false;
+    });
+    if (ri == -1) {
+      return INVALID_INPUT;
+    }
+    context.commit();
+    return ri;
+  }
   for (size_t ri = 0, re = index.size(); ri < re; ++ri) {
     auto& matcher = matchers[index[ri]];
 
@@ -423,12 +441,13 @@ DataRelayer::RelayChoice
   // become more complicated when we will start supporting ranges.
   auto getInputTimeslice = [&matchers = mInputMatchers,
                             &distinctRoutes = mDistinctRoutesIndex,
+                            &lookup = mInputMatchersIndex,
                             &rawHeader,
                             &index = mTimesliceIndex](VariableContext& context)
     -> std::tuple<int, TimesliceId> {
     /// FIXME: for the moment we only use the first context and reset
     /// between one invokation and the other.
-    auto input = matchToContext(rawHeader, matchers, distinctRoutes, context);
+    auto input = matchToContext(rawHeader, matchers, distinctRoutes, lookup, context);
 
     if (input == INVALID_INPUT) {
       return {
@@ -665,10 +684,13 @@ void DataRelayer::getReadyToProcess(std::vector<DataRelayer::RecordAction>& comp
   // These two are trivial, but in principle the whole loop could be parallelised
   // or vectorised so "completed" could be a thread local variable which needs
   // merging at the end.
-  auto updateCompletionResults = [&completed](TimesliceSlot li, uint64_t const* timeslice, CompletionPolicy::CompletionOp op) {
+  auto updateCompletionResults = [&completed, this](TimesliceSlot li, uint64_t const* timeslice, CompletionPolicy::CompletionOp op) {
     if (timeslice) {
       LOGP(debug, "Doing action {} for slot {} (timeslice: {})", (int)op, li.index, *timeslice);
       completed.emplace_back(RecordAction{li, {*timeslice}, op});
+      if (mClaimSlots) {
+        mClaimedSlots[li.index] = true;
+      }
     } else {
       LOGP(debug, "No timeslice associated with slot ", li.index);
     }
@@ -706,6 +728,12 @@ void DataRelayer::getReadyToProcess(std::vector<DataRelayer::RecordAction>& comp
       notDirty++;
       continue;
     }
+    // Another stream is working on it. We leave it dirty, so that
+    // it is checked again once released.
+    if (mClaimSlots && mClaimedSlots[li]) {
+      countWait++;
+      continue;
+    }
     if (!mCompletionPolicy.callbackFull) {
       throw runtime_error_f("Completion police %s has no callback set", mCompletionPolicy.name.c_str());
     }
@@ -775,6 +803,21 @@ void DataRelayer::getReadyToProcess(std::vector<DataRelayer::RecordAction>& comp
        countDiscard, countWait);
 }
 
+void DataRelayer::setClaimSlots(bool claim)
+{
+  std::scoped_lock<O2_LOCKABLE(std::recursive_mutex)> lock(mMutex);
+  mClaimSlots = claim;
+  std::fill(mClaimedSlots.begin(), mClaimedSlots.end(), false);
+}
+
+void DataRelayer::releaseSlot(TimesliceSlot slot)
+{
+  std::scoped_lock<O2_LOCKABLE(std::recursive_mutex)> lock(mMutex);
+  if (mClaimSlots) {
+    mClaimedSlots[slot.index] = false;
+  }
+}
+
 void DataRelayer::updateCacheStatus(TimesliceSlot slot, CacheEntryStatus oldStatus, CacheEntryStatus newStatus)
 {
   std::scoped_lock<O2_LOCKABLE(std::recursive_mutex)> lock(mMutex);
@@ -900,6 +943,7 @@ void DataRelayer::clear()
   for (size_t s = 0; s < mTimesliceIndex.size(); ++s) {
     mTimesliceIndex.markAsInvalid(TimesliceSlot{s});
   }
+  std::fill(mClaimedSlots.begin(), mClaimedSlots.end(), false);
 }
 
 size_t
@@ -918,6 +962,7 @@ void DataRelayer::setPipelineLength(size_t s)
 
   mTimesliceIndex.resize(s);
   mVariableContextes.resize(s);
+  mClaimedSlots.resize(s, false);
   publishMetrics();
 }
 
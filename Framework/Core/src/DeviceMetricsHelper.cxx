@@ -485,6 +485,68 @@ bool DeviceMetricsHelper::processMetric(ParsedMetricMatch& match,
   }
   assert(metricIndex != -1);
   // We are now guaranteed our metric is present at metricIndex.
+  return storeMetric(match, stringValue, metricIndex, info);
+}
+
+bool DeviceMetricsHelper::parseMetricId(std::string_view const s, uint32_t& id, std::string_view& name)
+{
+  constexpr std::string_view marker = "[METRIC_ID] ";
+  if (s.size() <= marker.size() || s.compare(0, marker.size(), marker) != 0) {
+    return false;
+  }
+  auto cur = s.data() + marker.size();
+  auto end = s.data() + s.size();
+  char* err = nullptr;
+  auto value = strtoul(cur, &err, 10);
+  if (err == cur || err >= end || *err != ' ') {
+    return false;
+  }
+  auto nameEnd = std::find_if(err + 1, end, [](char c) { return c == '\n' || c == '\0'; });
+  if (nameEnd == err + 1) {
+    return false;
+  }
+  id = value;
+  name = std::string_view(err + 1, nameEnd - err - 1);
+  return true;
+}
+
+bool DeviceMetricsHelper::processBinaryMetric(BinaryMetric const& metric, size_t metricIndex, DeviceMetricsInfo& info)
+{
+  if (metricIndex >= info.metrics.size() || info.metrics[metricIndex].type == MetricType::String) {
+    return false;
+  }
+  // Fill the same fields the text parser would, so that the
+  // store is updated in exactly the same way.
+  ParsedMetricMatch match;
+  match.timestamp = metric.timestamp;
+  match.type = metric.type;
+  switch (metric.type) {
+    case MetricType::Int:
+    case MetricType::Enum:
+      match.intValue = metric.intValue;
+      match.uint64Value = metric.intValue;
+      match.floatValue = metric.intValue;
+      break;
+    case MetricType::Float:
+      match.floatValue = metric.floatValue;
+      match.uint64Value = metric.floatValue;
+      match.intValue = metric.floatValue;
+      break;
+    case MetricType::Uint64:
+      match.uint64Value = metric.uint64Value;
+      match.intValue = metric.uint64Value;
+      match.floatValue = metric.uint64Value;
+      break;
+    default:
+      return false;
+  }
+  StringMetric stringValue;
+  stringValue.data[0] = '\0';
+  return storeMetric(match, stringValue, metricIndex, info);
+}
+
+bool DeviceMetricsHelper::storeMetric(ParsedMetricMatch const& match, StringMetric const& stringValue, size_t metricIndex, DeviceMetricsInfo& info)
+{
   MetricInfo& metricInfo = info.metrics[metricIndex];
 
   //  auto mod = info.timestamps[metricIndex].size();
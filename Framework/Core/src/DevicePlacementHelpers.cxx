@@ -0,0 +1,340 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#include "DevicePlacementHelpers.h"
+#include "DeviceSpecHelpers.h"
+#include "Framework/RuntimeError.h"
+
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+#include <numeric>
+#include <sstream>
+#include <thread>
+#include <unordered_map>
+
+#include <unistd.h>
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+namespace o2::framework
+{
+
+namespace
+{
+std::string readFirstLine(std::filesystem::path const& path)
+{
+  std::ifstream in(path);
+  std::string line;
+  std::getline(in, line);
+  return line;
+}
+
+/// PCI devices of class display controller (0x03xxxx) from NVIDIA or AMD.
+/// Other vendors are typically the BMC VGA of the server, which we ignore.
+bool isGPU(std::string const& pciClass, std::string const& vendor)
+{
+  return pciClass.rfind("0x03", 0) == 0 && (vendor == "0x10de" || vendor == "0x1002");
+}
+
+/// The topology we know about is the one of the host the driver runs on.
+bool isLocalHost(std::string const& hostname)
+{
+  if (hostname.empty() || hostname == "localhost" || hostname == "127.0.0.1") {
+    return true;
+  }
+  char localHostname[256] = {0};
+  return gethostname(localHostname, sizeof(localHostname) - 1) == 0 && hostname == localHostname;
+}
+
+/// The number of CPUs a device asks for: the "cpus" metadata if present,
+/// otherwise the number of streams it processes concurrently.
+size_t requestedCpus(DeviceSpec const& spec)
+{
+  for (auto& meta : spec.metadata) {
+    if (meta.key == "cpus") {
+      return std::max(1, std::stoi(meta.value));
+    }
+  }
+  for (auto& option : spec.options) {
+    if (option.name == "dpl-streams" && option.type == VariantType::Int) {
+      return std::max(1, option.defaultValue.get<int>());
+    }
+  }
+  return 1;
+}
+} // namespace
+
+DevicePlacementMode DevicePlacementHelpers::parsePlacementMode(std::string const& mode)
+{
+  if (mode == "none" || mode.empty()) {
+    return DevicePlacementMode::None;
+  } else if (mode == "node") {
+    return DevicePlacementMode::Node;
+  } else if (mode == "core") {
+    return DevicePlacementMode::Core;
+  }
+  throw runtime_error_f("Unknown placement mode %s. Valid values: none, node, core", mode.c_str());
+}
+
+std::vector<int> DevicePlacementHelpers::parseCpuList(std::string const& cpuList)
+{
+  std::vector<int> cpus;
+  std::istringstream str{cpuList};
+  std::string range;
+  while (std::getline(str, range, ',')) {
+    if (range.empty()) {
+      continue;
+    }
+    auto dash = range.find('-');
+    int first = std::stoi(range.substr(0, dash));
+    int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+    for (int cpu = first; cpu <= last; ++cpu) {
+      cpus.push_back(cpu);
+    }
+  }
+  return cpus;
+}
+
+std::string DevicePlacementHelpers::formatCpuList(std::vector<int> const& cpus)
+{
+  std::string result;
+  size_t i = 0;
+  while (i < cpus.size()) {
+    size_t j = i;
+    while (j + 1 < cpus.size() && cpus[j + 1] == cpus[j] + 1) {
+      ++j;
+    }
+    if (!result.empty()) {
+      result += ",";
+    }
+    result += std::to_string(cpus[i]);
+    if (j != i) {
+      result += "-" + std::to_string(cpus[j]);
+    }
+    i = j + 1;
+  }
+  return result;
+}
+
+std::vector<NumaNodeInfo> DevicePlacementHelpers::readTopology(std::string const& sysfsRoot)
+{
+  namespace fs = std::filesystem;
+  std::vector<NumaNodeInfo> nodes;
+  std::error_code ec;
+  fs::path nodesPath = fs::path(sysfsRoot) / "devices/system/node";
+  for (auto const& entry : fs::directory_iterator(nodesPath, ec)) {
+    auto name = entry.path().filename().string();
+    if (name.rfind("node", 0) != 0 || name.size() == 4 || !std::all_of(name.begin() + 4, name.end(), ::isdigit)) {
+      continue;
+    }
+    NumaNodeInfo node;
+    node.id = std::stoi(name.substr(4));
+    node.cpus = parseCpuList(readFirstLine(entry.path() / "cpulist"));
+    // Memory only nodes cannot run anything.
+    if (node.cpus.empty()) {
+      continue;
+    }
+    nodes.push_back(node);
+  }
+  std::sort(nodes.begin(), nodes.end(), [](auto const& a, auto const& b) { return a.id < b.id; });
+
+  if (nodes.empty()) {
+    NumaNodeInfo node;
+    node.cpus.resize(std::max(1u, std::thread::hardware_concurrency()));
+    std::iota(node.cpus.begin(), node.cpus.end(), 0);
+    nodes.push_back(node);
+  }
+
+  for (auto const& entry : fs::directory_iterator(fs::path(sysfsRoot) / "bus/pci/devices", ec)) {
+    if (!isGPU(readFirstLine(entry.path() / "class"), readFirstLine(entry.path() / "vendor"))) {
+      continue;
+    }
+    auto numaNode = readFirstLine(entry.path() / "numa_node");
+    int id = numaNode.empty() ? -1 : std::stoi(numaNode);
+    auto node = std::find_if(nodes.begin(), nodes.end(), [id](auto const& n) { return n.id == id; });
+    // Without NUMA information we attribute the GPU to the first node.
+    (node != nodes.end() ? *node : nodes.front()).gpus++;
+  }
+  return nodes;
+}
+
+void DevicePlacementHelpers::computePlacement(std::vector<DeviceSpec>& devices,
+                                              std::vector<NumaNodeInfo> const& nodes,
+                                              DevicePlacementMode mode)
+{
+  if (mode == DevicePlacementMode::None || nodes.empty()) {
+    return;
+  }
+  size_t totalCpus = 0;
+  for (auto const& node : nodes) {
+    totalCpus += node.cpus.size();
+  }
+
+  // Devices running on other hosts are left alone.
+  std::vector<size_t> indices;
+  for (size_t di = 0; di < devices.size(); ++di) {
+    if (isLocalHost(devices[di].resource.hostname)) {
+      indices.push_back(di);
+    }
+  }
+
+  size_t n = indices.size();
+  // Weight of the edges between the devices of this host. As we do
+  // not know the data volume upfront, we use the number of routes
+  // going through a channel as an estimate.
+  std::unordered_map<std::string, size_t> consumers;
+  for (size_t a = 0; a < n; ++a) {
+    for (auto& channel : devices[indices[a]].inputChannels) {
+      consumers[channel.name] = a;
+    }
+  }
+  std::vector<std::vector<int>> weights(n, std::vector<int>(n, 0));
+  auto addEdge = [&](size_t a, std::string const& channel) {
+    auto consumer = consumers.find(channel);
+    if (consumer == consumers.end() || consumer->second == a) {
+      return;
+    }
+    weights[a][consumer->second]++;
+    weights[consumer->second][a]++;
+  };
+  for (size_t a = 0; a < n; ++a) {
+    for (auto& route : devices[indices[a]].outputs) {
+      addEdge(a, route.channel);
+    }
+    for (auto& route : devices[indices[a]].forwards) {
+      addEdge(a, route.channel);
+    }
+  }
+
+  // Each node gets a share of the requested CPUs proportional to its CPUs.
+  std::vector<size_t> requested(n);
+  for (size_t a = 0; a < n; ++a) {
+    requested[a] = requestedCpus(devices[indices[a]]);
+  }
+  size_t totalRequested = std::accumulate(requested.begin(), requested.end(), size_t{0});
+  std::vector<size_t> capacity(nodes.size());
+  std::vector<size_t> load(nodes.size(), 0);
+  for (size_t k = 0; k < nodes.size(); ++k) {
+    capacity[k] = std::max<size_t>(1, (totalRequested * nodes[k].cpus.size() + totalCpus - 1) / totalCpus);
+  }
+  std::vector<int> assigned(n, -1);
+  auto assign = [&](size_t a, size_t k) {
+    assigned[a] = k;
+    load[k] += requested[a];
+  };
+  auto leastLoaded = [&](std::vector<size_t> const& candidates) {
+    return *std::min_element(candidates.begin(), candidates.end(), [&](size_t x, size_t y) {
+      return load[x] * capacity[y] < load[y] * capacity[x];
+    });
+  };
+
+  // Explicit requests and GPU affinity come first.
+  std::vector<size_t> gpuNodes;
+  for (size_t k = 0; k < nodes.size(); ++k) {
+    if (nodes[k].gpus) {
+      gpuNodes.push_back(k);
+    }
+  }
+  for (size_t a = 0; a < n; ++a) {
+    auto& spec = devices[indices[a]];
+    for (auto& meta : spec.metadata) {
+      if (meta.key != "numa-node" || assigned[a] != -1) {
+        continue;
+      }
+      int id = std::stoi(meta.value);
+      for (size_t k = 0; k < nodes.size(); ++k) {
+        if (nodes[k].id == id) {
+          assign(a, k);
+        }
+      }
+    }
+    if (assigned[a] == -1 && !gpuNodes.empty() && DeviceSpecHelpers::hasLabel(spec, "gpu")) {
+      assign(a, leastLoaded(gpuNodes));
+    }
+  }
+
+  // The rest is placed greedily, starting from the most connected
+  // devices, on the node where most of their peers already are.
+  std::vector<size_t> order(n);
+  std::iota(order.begin(), order.end(), 0);
+  std::vector<int> totalWeight(n);
+  for (size_t a = 0; a < n; ++a) {
+    totalWeight[a] = std::accumulate(weights[a].begin(), weights[a].end(), 0);
+  }
+  std::stable_sort(order.begin(), order.end(), [&](size_t x, size_t y) { return totalWeight[x] > totalWeight[y]; });
+  std::vector<size_t> allNodes(nodes.size());
+  std::iota(allNodes.begin(), allNodes.end(), 0);
+  for (auto a : order) {
+    if (assigned[a] != -1) {
+      continue;
+    }
+    std::vector<int> affinity(nodes.size(), 0);
+    for (size_t b = 0; b < n; ++b) {
+      if (assigned[b] != -1) {
+        affinity[assigned[b]] += weights[a][b];
+      }
+    }
+    std::vector<size_t> candidates;
+    for (size_t k = 0; k < nodes.size(); ++k) {
+      if (load[k] + requested[a] <= capacity[k]) {
+        candidates.push_back(k);
+      }
+    }
+    if (candidates.empty()) {
+      assign(a, leastLoaded(allNodes));
+      continue;
+    }
+    auto mostAffine = *std::max_element(candidates.begin(), candidates.end(), [&](size_t x, size_t y) { return affinity[x] < affinity[y]; });
+    int best = affinity[mostAffine];
+    candidates.erase(std::remove_if(candidates.begin(), candidates.end(), [&](size_t k) { return affinity[k] != best; }), candidates.end());
+    assign(a, leastLoaded(candidates));
+  }
+
+  // Translate the plan in a set of CPUs for each device.
+  std::vector<size_t> placed(nodes.size(), 0);
+  for (size_t a = 0; a < n; ++a) {
+    auto& node = nodes[assigned[a]];
+    auto& resource = devices[indices[a]].resource;
+    resource.numaNode = node.id;
+    if (mode == DevicePlacementMode::Node) {
+      resource.cpuSet = formatCpuList(node.cpus);
+      continue;
+    }
+    // Each device gets its own slice of the node, proportional to the
+    // CPUs it asked for. In case there are more devices than CPUs,
+    // slices are shared round robin.
+    size_t slice = std::clamp<size_t>(node.cpus.size() * requested[a] / load[assigned[a]], 1, node.cpus.size());
+    size_t first = placed[assigned[a]] % node.cpus.size();
+    placed[assigned[a]] += slice;
+    std::vector<int> cpus(node.cpus.begin() + first, node.cpus.begin() + std::min(first + slice, node.cpus.size()));
+    resource.cpuSet = formatCpuList(cpus);
+  }
+}
+
+bool DevicePlacementHelpers::applyCpuAffinity(std::string const& cpuList)
+{
+#if defined(__linux__)
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  for (auto cpu : parseCpuList(cpuList)) {
+    if (cpu >= 0 && cpu < CPU_SETSIZE) {
+      CPU_SET(cpu, &set);
+    }
+  }
+  return sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+  return false;
+#endif
+}
+
+} // namespace o2::framework
@@ -0,0 +1,71 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#ifndef O2_FRAMEWORK_DEVICEPLACEMENTHELPERS_H_
+#define O2_FRAMEWORK_DEVICEPLACEMENTHELPERS_H_
+
+#include "Framework/DeviceSpec.h"
+
+#include <string>
+#include <vector>
+
+namespace o2::framework
+{
+
+/// How devices should be placed on the CPUs of the host they run on.
+enum struct DevicePlacementMode {
+  None, /// No placement, the kernel schedules devices everywhere
+  Node, /// Pin each device to all the CPUs of a NUMA node
+  Core  /// Pin each device to a disjoint subset of the CPUs of a NUMA node
+};
+
+/// A NUMA node of the host, with the CPUs it contains and the number
+/// of GPUs which are attached to it.
+struct NumaNodeInfo {
+  int id = 0;
+  std::vector<int> cpus;
+  int gpus = 0;
+};
+
+struct DevicePlacementHelpers {
+  /// Parse the value of the --numa-placement option: none, node or core.
+  static DevicePlacementMode parsePlacementMode(std::string const& mode);
+
+  /// Parse a list of CPUs in the kernel cpulist format, e.g. "0-3,8,10-11".
+  static std::vector<int> parseCpuList(std::string const& cpuList);
+  /// Format a list of CPUs in the kernel cpulist format.
+  static std::string formatCpuList(std::vector<int> const& cpus);
+
+  /// Read the NUMA topology of localhost from @a sysfsRoot (normally /sys).
+  /// In case it cannot be read, a single node containing all the CPUs is returned.
+  static std::vector<NumaNodeInfo> readTopology(std::string const& sysfsRoot = "/sys");
+
+  /// Compute a placement plan for @a devices on @a nodes and record it in
+  /// the resource of each device. Devices exchanging data are kept on the
+  /// same node, weighting each channel by the number of routes it carries.
+  /// Devices with the "numa-node" metadata are forced on the given node,
+  /// devices with the "gpu" label go to the nodes which have a GPU attached.
+  /// The CPUs are shared according to what each device asks for, i.e.
+  /// the "cpus" metadata or the "dpl-streams" option, one by default.
+  /// Since @a nodes describes localhost, devices on other hosts are not placed.
+  static void computePlacement(std::vector<DeviceSpec>& devices,
+                               std::vector<NumaNodeInfo> const& nodes,
+                               DevicePlacementMode mode);
+
+  /// Pin the calling thread, and therefore all the threads it creates
+  /// afterwards, to the CPUs in @a cpuList.
+  /// @return false if the affinity could not be set.
+  static bool applyCpuAffinity(std::string const& cpuList);
+};
+
+} // namespace o2::framework
+
+#endif // O2_FRAMEWORK_DEVICEPLACEMENTHELPERS_H_
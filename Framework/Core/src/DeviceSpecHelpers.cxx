@@ -1539,6 +1539,7 @@ void DeviceSpecHelpers::prepareArguments(bool defaultQuiet, bool defaultStopped,
         realOdesc.add_options()("early-forward-policy", bpo::value<std::string>());
         realOdesc.add_options()("session", bpo::value<std::string>());
         realOdesc.add_options()("signposts", bpo::value<std::string>());
+        realOdesc.add_options()("signposts-trace", bpo::value<std::string>());
         filterArgsFct(expansions.we_wordc, expansions.we_wordv, realOdesc);
         wordfree(&expansions);
         return;
@@ -1647,6 +1648,10 @@ void DeviceSpecHelpers::prepareArguments(bool defaultQuiet, bool defaultStopped,
       updateDeviceArguments(std::string("--resources-monitoring"), std::to_string(spec.resourceMonitoringInterval));
     }
 
+    if (!spec.resource.cpuSet.empty()) {
+      updateDeviceArguments(std::string("--cpu-affinity"), spec.resource.cpuSet);
+    }
+
     // We create the final option list, depending on the channels
     // which are present in a device.
     for (auto& arg : tmpArgs) {
@@ -1694,6 +1699,7 @@ boost::program_options::options_description DeviceSpecHelpers::getForwardedDevic
   // - child-driver is not a FairMQ device option but used per device to start to process
   bpo::options_description forwardedDeviceOptions;
   char const* defaultSignposts = getenv("DPL_SIGNPOSTS") ? getenv("DPL_SIGNPOSTS") : "";
+  char const* defaultSignpostsTrace = getenv("DPL_SIGNPOSTS_TRACE") ? getenv("DPL_SIGNPOSTS_TRACE") : "";
   forwardedDeviceOptions.add_options()                                                                                                                               //
     ("severity", bpo::value<std::string>()->default_value("info"), "severity level of the log")                                                                      //
     ("plugin,P", bpo::value<std::string>(), "FairMQ plugin list")                                                                                                    //
@@ -1734,6 +1740,8 @@ boost::program_options::options_description DeviceSpecHelpers::getForwardedDevic
     ("dpl-tracing-flags", bpo::value<std::string>(), "pipe separated list of events to trace")                                                                       //
     ("signposts", bpo::value<std::string>()->default_value(defaultSignposts),                                                                                        //
      "comma separated list of signposts to enable (any of `completion`, `data_processor_context`, `stream_context`, `device`, `monitoring_service`)")                //
+    ("signposts-trace", bpo::value<std::string>()->default_value(defaultSignpostsTrace),                                                                             //
+     "comma separated list of signposts to record in a Chrome trace, dumped in dpl-trace-<device>.json")                                                             //
     ("child-driver", bpo::value<std::string>(), "external driver to start childs with (e.g. valgrind)");                                                             //
 
   return forwardedDeviceOptions;
@@ -12,6 +12,7 @@
 #include "Framework/FairMQDeviceProxy.h"
 #include "Framework/DataSpecUtils.h"
 #include "InputRouteHelpers.h"
+#include "OutputMessagePool.h"
 #include "Framework/DataProcessingHeader.h"
 #include "Headers/DataHeader.h"
 #include "Headers/DataHeaderHelpers.h"
@@ -205,14 +206,28 @@ fair::mq::TransportFactory* FairMQDeviceProxy::getForwardTransport(RouteIndex in
 
 std::unique_ptr<fair::mq::Message> FairMQDeviceProxy::createOutputMessage(RouteIndex routeIndex) const
 {
+  mOutputMessagesCreated.fetch_add(1, std::memory_order_relaxed);
   return getOutputTransport(routeIndex)->CreateMessage(fair::mq::Alignment{64});
 }
 
 std::unique_ptr<fair::mq::Message> FairMQDeviceProxy::createOutputMessage(RouteIndex routeIndex, const size_t size) const
 {
+  mOutputMessagesCreated.fetch_add(1, std::memory_order_relaxed);
+  if (routeIndex.value < mOutputPools.size() && mOutputPools[routeIndex.value]) {
+    if (auto message = mOutputPools[routeIndex.value]->create(size)) {
+      mOutputMessagesPooled.fetch_add(1, std::memory_order_relaxed);
+      return message;
+    }
+  }
   return getOutputTransport(routeIndex)->CreateMessage(size, fair::mq::Alignment{64});
 }
 
+std::pair<int64_t, int64_t> FairMQDeviceProxy::consumeOutputMessagesCount()
+{
+  return {mOutputMessagesCreated.exchange(0, std::memory_order_relaxed),
+          mOutputMessagesPooled.exchange(0, std::memory_order_relaxed)};
+}
+
 std::unique_ptr<fair::mq::Message> FairMQDeviceProxy::createInputMessage(RouteIndex routeIndex) const
 {
   return getInputTransport(routeIndex)->CreateMessage(fair::mq::Alignment{64});
@@ -236,6 +251,7 @@ void FairMQDeviceProxy::bind(std::vector<OutputRoute> const& outputs, std::vecto
   mOutputRoutes.clear();
   mOutputChannelInfos.clear();
   mOutputChannelStates.clear();
+  mOutputPools.clear();
   mInputs.clear();
   mInputRoutes.clear();
   mInputChannels.clear();
@@ -279,6 +295,17 @@ void FairMQDeviceProxy::bind(std::vector<OutputRoute> const& outputs, std::vecto
       }
       LOGP(detail, "Binding route {}@{}%{} to index {} and channelIndex {}", DataSpecUtils::describe(route.matcher), route.timeslice, route.maxTimeslices, ri, channelIndex.value);
       mOutputRoutes.emplace_back(RouteState{channelIndex, false});
+      std::shared_ptr<OutputMessagePool> pool;
+      for (auto& meta : route.matcher.metadata) {
+        if (meta.name == "output-pool-size") {
+          auto poolSize = (size_t)meta.defaultValue.get<int>() * 1024 * 1024;
+          if (poolSize) {
+            LOGP(info, "Using an output pool of {} MB for {}", poolSize / (1024 * 1024), DataSpecUtils::describe(route.matcher));
+            pool = std::make_shared<OutputMessagePool>(*mOutputChannelInfos[channelIndex.value].channel.Transport(), poolSize);
+          }
+        }
+      }
+      mOutputPools.emplace_back(std::move(pool));
       ri++;
     }
 #ifndef NDEBUG
@@ -14,6 +14,7 @@
 #include "Framework/ObjectCache.h"
 #include "Framework/CallbackService.h"
 #include <fairmq/Message.h>
+#include <algorithm>
 #include <cassert>
 
 #if defined(__GNUC__)
@@ -35,29 +36,52 @@ namespace o2::framework
 
 InputRecord::InputRecord(std::vector<InputRoute> const& inputsSchema,
                          InputSpan& span,
-                         ServiceRegistryRef registry)
+                         ServiceRegistryRef registry,
+                         std::shared_ptr<InputIndex const> index)
   : mRegistry{registry},
     mInputsSchema{inputsSchema},
-    mSpan{span}
+    mSpan{span},
+    mIndex{index ? std::move(index) : buildIndex(inputsSchema)}
 {
 }
 
-int InputRecord::getPos(const char* binding) const
+std::shared_ptr<InputRecord::InputIndex const> InputRecord::buildIndex(std::vector<InputRoute> const& schema)
 {
-  auto inputIndex = 0;
-  for (size_t i = 0; i < mInputsSchema.size(); ++i) {
-    auto& route = mInputsSchema[i];
+  auto index = std::make_shared<InputIndex>();
+  int inputIndex = 0;
+  for (size_t i = 0; i < schema.size(); ++i) {
+    auto& route = schema[i];
     if (route.timeslice != 0) {
       continue;
     }
-    if (route.matcher.binding == binding) {
-      return inputIndex;
-    }
+    char const* name = route.matcher.binding.c_str();
+    index->bindings.push_back({runtime_hash(name), inputIndex, name});
+    index->schemaIndices.push_back(i);
     ++inputIndex;
   }
+  // Keep the original order for equal hashes, so that the first
+  // matching binding wins, like it used to with the linear search.
+  std::stable_sort(index->bindings.begin(), index->bindings.end(), [](auto const& a, auto const& b) { return a.hash < b.hash; });
+  return index;
+}
+
+int InputRecord::getPos(uint32_t hash, const char* binding) const
+{
+  auto const& bindings = mIndex->bindings;
+  auto it = std::lower_bound(bindings.begin(), bindings.end(), hash, [](InputIndex::Binding const& b, uint32_t h) { return b.hash < h; });
+  for (; it != bindings.end() && it->hash == hash; ++it) {
+    if (strcmp(it->name, binding) == 0) {
+      return it->pos;
+    }
+  }
   return -1;
 }
 
+int InputRecord::getPos(const char* binding) const
+{
+  return getPos(runtime_hash(binding), binding);
+}
+
 InputRecord::InputPos InputRecord::getPos(std::vector<InputRoute> const& schema, ConcreteDataMatcher concrete)
 {
   size_t inputIndex = 0;
@@ -80,7 +104,18 @@ int InputRecord::getPos(std::string const& binding) const
 
 DataRef InputRecord::getByPos(int pos, int part) const
 {
-  return InputRecord::getByPos(mInputsSchema, mSpan, pos, part);
+  if (pos >= (int)mSpan.size() || pos < 0) {
+    throw runtime_error_f("Unknown message requested at position %d", pos);
+  }
+  if (part > 0 && part >= (int)mSpan.getNofParts(pos)) {
+    throw runtime_error_f("Invalid message part index at %d:%d", pos, part);
+  }
+  if (pos >= (int)mIndex->schemaIndices.size()) {
+    throw runtime_error_f("Unknown schema at position %d", pos);
+  }
+  auto ref = mSpan.get(pos, part);
+  ref.spec = &mInputsSchema[mIndex->schemaIndices[pos]].matcher;
+  return ref;
 }
 
 DataRef InputRecord::getByPos(std::vector<InputRoute> const& schema, InputSpan const& span, int pos, int part)
@@ -19,8 +19,7 @@ namespace o2::framework
 
 fair::mq::MessagePtr MessageContext::createMessage(RouteIndex routeIndex, int index, size_t size)
 {
-  auto* transport = mProxy.getOutputTransport(routeIndex);
-  return transport->CreateMessage(size, fair::mq::Alignment{64});
+  return mProxy.createOutputMessage(routeIndex, size);
 }
 
 fair::mq::MessagePtr MessageContext::createMessage(RouteIndex routeIndex, int index, void* data, size_t size, fair::mq::FreeFn* ffn, void* hint)
@@ -46,6 +45,17 @@ o2::header::DataHeader* MessageContext::findMessageHeader(const Output& spec)
   return nullptr;
 }
 
+void const* MessageContext::findMessagePayload(const Output& spec)
+{
+  for (auto it = mMessages.rbegin(); it != mMessages.rend(); ++it) {
+    const auto* hd = (*it)->header();
+    if (hd->dataOrigin == spec.origin && hd->dataDescription == spec.description && hd->subSpecification == spec.subSpec) {
+      return (*it)->payload();
+    }
+  }
+  return nullptr;
+}
+
 o2::framework::DataProcessingHeader* MessageContext::findMessageDataProcessingHeader(const Output& spec)
 {
   for (auto it = mMessages.rbegin(); it != mMessages.rend(); ++it) {
@@ -105,6 +115,17 @@ void MessageContext::clear()
   assert(std::all_of(mMessages.begin(), mMessages.end(), [](auto& m) { return m->empty(); }));
   mDidDispatch = false;
   mMessages.clear();
+  // Serialized buffers which were not sent during the last timeslice are
+  // most likely for objects which are gone, release them.
+  for (auto it = mSerializationCache.begin(); it != mSerializationCache.end();) {
+    if (it->second.used) {
+      it->second.used = false;
+      ++it;
+      continue;
+    }
+    pruneFromCache(it->second.cacheId);
+    it = mSerializationCache.erase(it);
+  }
 }
 
 int64_t MessageContext::addToCache(std::unique_ptr<fair::mq::Message>& toCache)
@@ -130,6 +151,35 @@ void MessageContext::pruneFromCache(int64_t id)
   mMessageCache.erase(id);
 }
 
+std::unique_ptr<fair::mq::Message> MessageContext::cloneFromSerializationCache(void const* object, size_t type, uint64_t version,
+                                                                               fair::mq::TransportFactory const* transport)
+{
+  auto entry = mSerializationCache.find(object);
+  if (entry == mSerializationCache.end() || entry->second.type != type || entry->second.version != version) {
+    return nullptr;
+  }
+  auto& inCache = mMessageCache.at(entry->second.cacheId);
+  if (inCache->GetTransport() != transport) {
+    return nullptr;
+  }
+  entry->second.used = true;
+  return cloneFromCache(entry->second.cacheId);
+}
+
+void MessageContext::addToSerializationCache(void const* object, size_t type, uint64_t version, std::unique_ptr<fair::mq::Message>& message)
+{
+  auto entry = mSerializationCache.find(object);
+  if (entry != mSerializationCache.end()) {
+    // A new version of the same object, the old buffer is released
+    // as soon as all the consumers are done with it.
+    pruneFromCache(entry->second.cacheId);
+    mSerializationCache.erase(entry);
+  } else if (mSerializationCache.size() >= MaxSerializationCacheEntries) {
+    return;
+  }
+  mSerializationCache.insert({object, SerializationCacheEntry{type, version, addToCache(message), true}});
+}
+
 void MessageContext::schedule(Messages::value_type&& message)
 {
   auto const* header = message->header();
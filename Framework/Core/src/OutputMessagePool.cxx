@@ -0,0 +1,131 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#include "OutputMessagePool.h"
+#include "Framework/Logger.h"
+
+#include <fairmq/Message.h>
+#include <fairmq/TransportFactory.h>
+#include <fairmq/UnmanagedRegion.h>
+
+namespace o2::framework
+{
+
+OutputMessagePool::OutputMessagePool(fair::mq::TransportFactory& transport, size_t regionSize)
+  : mTransport{transport},
+    mRegionSize{regionSize}
+{
+  fair::mq::RegionConfig config;
+  config.lock = false;
+  config.zero = false;
+  mRegion = mTransport.CreateUnmanagedRegion(
+    regionSize, [this](std::vector<fair::mq::RegionBlock> const& blocks) {
+      for (auto& block : blocks) {
+        this->release(block.ptr, reinterpret_cast<size_t>(block.hint));
+      }
+    },
+    config);
+  mBase = static_cast<char*>(mRegion->GetData());
+  LOGP(detail, "Created output message pool of {} bytes", regionSize);
+}
+
+OutputMessagePool::~OutputMessagePool()
+{
+  // Make sure no callback can reach us once we are gone.
+  mRegion.reset();
+}
+
+size_t OutputMessagePool::sizeClass(size_t size)
+{
+  size_t sc = 0;
+  while (((size_t)1 << (sc + MIN_BLOCK_SHIFT)) < size) {
+    ++sc;
+  }
+  return sc;
+}
+
+std::unique_ptr<fair::mq::Message> OutputMessagePool::create(size_t size)
+{
+  if (size == 0) {
+    return nullptr;
+  }
+  auto sc = sizeClass(size);
+  if (sc >= MAX_SIZE_CLASSES) {
+    return nullptr;
+  }
+  size_t offset = 0;
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (!allocate(sc, offset)) {
+      return nullptr;
+    }
+  }
+  return mTransport.CreateMessage(mRegion, mBase + offset, size, reinterpret_cast<void*>(sc));
+}
+
+bool OutputMessagePool::allocate(size_t sc, size_t& offset)
+{
+  // Reuse a block of the same class, or split a larger one.
+  for (size_t larger = sc; larger < MAX_SIZE_CLASSES; ++larger) {
+    if (mFreeBlocks[larger].empty()) {
+      continue;
+    }
+    offset = *mFreeBlocks[larger].begin();
+    mFreeBlocks[larger].erase(mFreeBlocks[larger].begin());
+    for (; larger > sc; --larger) {
+      mFreeBlocks[larger - 1].insert(offset + blockSize(larger - 1));
+    }
+    mReused.fetch_add(1, std::memory_order_relaxed);
+    return true;
+  }
+  // Carve a new one, aligned to its size, out of the region.
+  size_t aligned = (mOffset + blockSize(sc) - 1) & ~(blockSize(sc) - 1);
+  if (aligned + blockSize(sc) > mRegionSize) {
+    return false;
+  }
+  addFreeRange(mOffset, aligned);
+  offset = aligned;
+  mOffset = aligned + blockSize(sc);
+  return true;
+}
+
+void OutputMessagePool::addFreeRange(size_t begin, size_t end)
+{
+  // Both ends are multiples of the smallest block, so the range is
+  // covered by the largest blocks aligned at each offset.
+  while (begin < end) {
+    size_t sc = 0;
+    while (sc + 1 < MAX_SIZE_CLASSES && (begin & (blockSize(sc + 1) - 1)) == 0 && begin + blockSize(sc + 1) <= end) {
+      ++sc;
+    }
+    mFreeBlocks[sc].insert(begin);
+    begin += blockSize(sc);
+  }
+}
+
+void OutputMessagePool::release(void* ptr, size_t sc)
+{
+  size_t offset = static_cast<char*>(ptr) - mBase;
+  std::lock_guard<std::mutex> lock(mMutex);
+  // Merge with the buddy for as long as it is free.
+  while (sc + 1 < MAX_SIZE_CLASSES) {
+    auto buddy = mFreeBlocks[sc].find(offset ^ blockSize(sc));
+    if (buddy == mFreeBlocks[sc].end()) {
+      break;
+    }
+    mFreeBlocks[sc].erase(buddy);
+    offset &= ~blockSize(sc);
+    ++sc;
+  }
+  mFreeBlocks[sc].insert(offset);
+}
+
+} // namespace o2::framework
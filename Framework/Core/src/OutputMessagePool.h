@@ -0,0 +1,81 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#ifndef O2_FRAMEWORK_OUTPUTMESSAGEPOOL_H_
+#define O2_FRAMEWORK_OUTPUTMESSAGEPOOL_H_
+
+#include <fairmq/FwdDecls.h>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <set>
+
+namespace o2::framework
+{
+
+/// A pool of payload buffers carved out of a fair::mq::UnmanagedRegion
+/// associated to a single output route. Buffers are grouped in power of
+/// two size classes. Once the receiving side is done with a message the
+/// region callback hands the buffer back to the free list of its class,
+/// so that the following timeframes can reuse it without going through
+/// the (locked) shared memory segment allocator.
+///
+/// Blocks are aligned to their size within the region, so that a block
+/// which is released while its buddy is free is merged with it, and a
+/// larger free block is split when a smaller class has nothing left. This
+/// way a change in the size of the messages does not exhaust the region.
+class OutputMessagePool
+{
+ public:
+  /// Smallest block handed out by the pool (4 KiB). Smaller messages are
+  /// better served by the transport itself.
+  static constexpr size_t MIN_BLOCK_SHIFT = 12;
+  static constexpr size_t MAX_SIZE_CLASSES = 48;
+
+  OutputMessagePool(fair::mq::TransportFactory& transport, size_t regionSize);
+  ~OutputMessagePool();
+
+  /// @return a message of @a size bytes backed by the pool region, or
+  /// nullptr in case the request cannot be satisfied, in which case the
+  /// caller is expected to fall back to the transport allocator.
+  std::unique_ptr<fair::mq::Message> create(size_t size);
+
+  /// Number of messages served by recycling a previously released block.
+  [[nodiscard]] size_t reused() const { return mReused.load(std::memory_order_relaxed); }
+
+  /// @return the size class for a message of @a size bytes.
+  static size_t sizeClass(size_t size);
+  /// @return the size of the blocks of size class @a sc.
+  static size_t blockSize(size_t sc) { return (size_t)1 << (sc + MIN_BLOCK_SHIFT); }
+
+ private:
+  /// @return false if there is no room left for a block of class @a sc.
+  bool allocate(size_t sc, size_t& offset);
+  /// Add the blocks making up [@a begin, @a end) to the free lists.
+  void addFreeRange(size_t begin, size_t end);
+  void release(void* ptr, size_t sizeClass);
+
+  fair::mq::TransportFactory& mTransport;
+  std::unique_ptr<fair::mq::UnmanagedRegion> mRegion;
+  char* mBase = nullptr;
+  std::mutex mMutex;
+  /// Offsets in the region of the free blocks of each size class.
+  std::array<std::set<size_t>, MAX_SIZE_CLASSES> mFreeBlocks;
+  size_t mRegionSize = 0;
+  size_t mOffset = 0;
+  std::atomic<size_t> mReused = 0;
+};
+
+} // namespace o2::framework
+
+#endif // O2_FRAMEWORK_OUTPUTMESSAGEPOOL_H_
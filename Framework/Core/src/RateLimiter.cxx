@@ -16,15 +16,129 @@
 #include "Framework/DataTakingContext.h"
 #include "Framework/DeviceState.h"
 #include "Framework/DeviceContext.h"
+#include "Framework/DataProcessingStats.h"
 #include <fairmq/Device.h>
 #include <uv.h>
 #include <fairmq/shmem/Monitor.h>
 #include <fairmq/shmem/Common.h>
+#include <algorithm>
 #include <chrono>
 #include <thread>
 
 using namespace o2::framework;
 
+namespace
+{
+/// @return the free memory in the shared memory segment used by the workflow, -1 if unknown
+long getFreeSHM(fair::mq::Device* device, RunningWorkflowInfo const& runningWorkflow)
+{
+  long freeMemory = -1;
+  try {
+    freeMemory = fair::mq::shmem::Monitor::GetFreeMemory(fair::mq::shmem::ShmId{fair::mq::shmem::makeShmIdStr(device->fConfig->GetProperty<uint64_t>("shmid"))}, runningWorkflow.shmSegmentId);
+  } catch (...) {
+  }
+  if (freeMemory == -1) {
+    try {
+      freeMemory = fair::mq::shmem::Monitor::GetFreeMemory(fair::mq::shmem::SessionId{device->fConfig->GetProperty<std::string>("session")}, runningWorkflow.shmSegmentId);
+    } catch (...) {
+    }
+  }
+  return freeMemory;
+}
+} // namespace
+
+void AdaptiveRateLimit::sent(int64_t tf, TimePoint when)
+{
+  if (!mSendTimes.empty()) {
+    mSendTimes[tf % mSendTimes.size()] = when;
+  }
+  mSent = tf + 1;
+}
+
+void AdaptiveRateLimit::consumed(int64_t consumed, TimePoint when)
+{
+  // Time between the publishing of a timeframe and the moment the whole
+  // workflow is done with it, smoothed over the last few timeframes.
+  for (int64_t tf = mConsumed; tf < consumed && tf < mSent && !mSendTimes.empty(); ++tf) {
+    float latency = std::chrono::duration_cast<std::chrono::duration<float>>(when - mSendTimes[tf % mSendTimes.size()]).count();
+    mLatency = mLatency == 0.f ? latency : 0.8f * mLatency + 0.2f * latency;
+    mMinLatency = mMinLatency == 0.f ? latency : std::min(mMinLatency, latency);
+    mWindowMinLatency = mWindowMinLatency == 0.f ? latency : std::min(mWindowMinLatency, latency);
+    // The best latency of the last window replaces the previous one, so
+    // that a workflow which became slower is not considered congested forever.
+    if (when - mWindowStart > MinLatencyWindow) {
+      mMinLatency = mWindowMinLatency;
+      mWindowMinLatency = 0.f;
+      mWindowStart = when;
+    }
+  }
+  mConsumed = std::max(mConsumed, consumed);
+}
+
+void AdaptiveRateLimit::update(int maxInFlight, int64_t sentTimeframes, float shmOccupancy)
+{
+  if (mLimit == 0.f) {
+    mLimit = maxInFlight;
+  }
+  mSendTimes.resize(maxInFlight);
+
+  bool shmPressure = shmOccupancy > HighSHMOccupancy;
+  bool latencyPressure = mMinLatency > 0.f && mLatency > MaxLatencyRatio * mMinLatency;
+  if (shmPressure || latencyPressure) {
+    // Multiplicative decrease, at most once per round of in flight timeframes,
+    // so that the effect of the previous decrease can be observed.
+    if (sentTimeframes - mLastDecrease >= (int64_t)mLimit) {
+      mLimit = std::max(1.f, mLimit * DecreaseFactor);
+      mLastDecrease = sentTimeframes;
+      LOG(detail) << "Adaptive rate limiting: reducing TFs in flight to " << mLimit << " (SHM occupancy " << shmOccupancy << ", latency " << mLatency << " s, best " << mMinLatency << " s)";
+    }
+  } else if (shmOccupancy < LowSHMOccupancy) {
+    // Additive increase, one more timeframe in flight per round.
+    mLimit = std::min((float)maxInFlight, mLimit + 1.f / mLimit);
+  }
+}
+
+void RateLimiter::updateConsumed(int64_t consumed)
+{
+  mAdaptive.consumed(consumed, std::chrono::system_clock::now());
+  mConsumedTimeframes = consumed;
+}
+
+void RateLimiter::updateAdaptiveLimit(ProcessingContext& ctx, int maxInFlight)
+{
+  auto device = ctx.services().get<RawDeviceService>().device();
+
+  // Pick up any consumption feedback which is already there, without waiting.
+  auto msg = device->NewMessageFor("metric-feedback", 0, 0);
+  while (device->Receive(msg, "metric-feedback", 0, 0) > 0) {
+    assert(msg->GetSize() == 8);
+    updateConsumed(*(int64_t*)msg->GetData());
+  }
+
+  // Asking the segment for its free memory is not free, so we do not do it
+  // for every timeframe.
+  auto now = std::chrono::system_clock::now();
+  if (now - mLastSHMSample >= SHMSamplingInterval) {
+    mLastSHMSample = now;
+    mSHMOccupancy = -1.f;
+    try {
+      auto segmentSize = device->fConfig->GetProperty<uint64_t>("shm-segment-size");
+      auto freeMemory = getFreeSHM(device, ctx.services().get<RunningWorkflowInfo const>());
+      if (segmentSize && freeMemory >= 0) {
+        mSHMOccupancy = 1.f - (float)freeMemory / (float)segmentSize;
+      }
+    } catch (...) {
+    }
+  }
+
+  mAdaptive.update(maxInFlight, mSentTimeframes, mSHMOccupancy);
+
+  auto& stats = ctx.services().get<DataProcessingStats>();
+  stats.updateStats({(short)ProcessingStatsId::RATE_LIMIT_TFS_IN_FLIGHT, DataProcessingStats::Op::Set, (int64_t)mAdaptive.limit()});
+  stats.updateStats({(short)ProcessingStatsId::RATE_LIMIT_SHM_OCCUPANCY, DataProcessingStats::Op::Set, (int64_t)(mSHMOccupancy * 1000.f)});
+  stats.updateStats({(short)ProcessingStatsId::RATE_LIMIT_LATENCY_MS, DataProcessingStats::Op::Set, (int64_t)(mAdaptive.latency() * 1000.f)});
+}
+
 int RateLimiter::check(ProcessingContext& ctx, int maxInFlight, size_t minSHM)
 {
   if (!maxInFlight && !minSHM) {
@@ -33,6 +147,12 @@ int RateLimiter::check(ProcessingContext& ctx, int maxInFlight, size_t minSHM)
   auto device = ctx.services().get<RawDeviceService>().device();
   auto& deviceState = ctx.services().get<DeviceState>();
   if (maxInFlight && device->GetChannels().count("metric-feedback")) {
+    static bool adaptive = getenv("DPL_ADAPTIVE_RATE_LIMITING") && atoi(getenv("DPL_ADAPTIVE_RATE_LIMITING"));
+    int limit = maxInFlight;
+    if (adaptive) {
+      updateAdaptiveLimit(ctx, maxInFlight);
+      limit = std::max(1, (int)mAdaptive.limit());
+    }
     auto& dtc = ctx.services().get<DataTakingContext>();
     const auto& device = ctx.services().get<RawDeviceService>().device();
     const auto& deviceContext = ctx.services().get<DeviceContext>();
@@ -42,12 +162,12 @@ int RateLimiter::check(ProcessingContext& ctx, int maxInFlight, size_t minSHM)
     int recvTimeout = 0;
     auto startTime = std::chrono::system_clock::now();
     static constexpr float MESSAGE_DELAY_TIME = 15.f;
-    while ((mSentTimeframes - mConsumedTimeframes) >= maxInFlight) {
+    while ((mSentTimeframes - mConsumedTimeframes) >= limit) {
       if (recvTimeout != 0 && !waitMessage && (timeoutForMessage == false || std::chrono::duration_cast<std::chrono::duration<float>>(std::chrono::system_clock::now() - startTime).count() > MESSAGE_DELAY_TIME)) {
         if (dtc.deploymentMode == DeploymentMode::OnlineDDS || dtc.deploymentMode == DeploymentMode::OnlineECS || dtc.deploymentMode == DeploymentMode::FST) {
-          LOG(alarm) << "Maximum number of TF in flight reached (" << maxInFlight << ": published " << mSentTimeframes << " - finished " << mConsumedTimeframes << "), waiting";
+          LOG(alarm) << "Maximum number of TF in flight reached (" << limit << ": published " << mSentTimeframes << " - finished " << mConsumedTimeframes << "), waiting";
         } else {
-          LOG(info) << "Maximum number of TF in flight reached (" << maxInFlight << ": published " << mSentTimeframes << " - finished " << mConsumedTimeframes << "), waiting";
+          LOG(info) << "Maximum number of TF in flight reached (" << limit << ": published " << mSentTimeframes << " - finished " << mConsumedTimeframes << "), waiting";
         }
         waitMessage = true;
         timeoutForMessage = false;
@@ -66,13 +186,13 @@ int RateLimiter::check(ProcessingContext& ctx, int maxInFlight, size_t minSHM)
         continue;
       }
       assert(msg->GetSize() == 8);
-      mConsumedTimeframes = *(int64_t*)msg->GetData();
+      updateConsumed(*(int64_t*)msg->GetData());
     }
     if (waitMessage) {
       if (dtc.deploymentMode == DeploymentMode::OnlineDDS || dtc.deploymentMode == DeploymentMode::OnlineECS || dtc.deploymentMode == DeploymentMode::FST) {
-        LOG(important) << (mSentTimeframes - mConsumedTimeframes) << " / " << maxInFlight << " TF in flight, continuing to publish";
+        LOG(important) << (mSentTimeframes - mConsumedTimeframes) << " / " << limit << " TF in flight, continuing to publish";
       } else {
-        LOG(info) << (mSentTimeframes - mConsumedTimeframes) << " / " << maxInFlight << " TF in flight, continuing to publish";
+        LOG(info) << (mSentTimeframes - mConsumedTimeframes) << " / " << limit << " TF in flight, continuing to publish";
       }
     }
 
@@ -124,22 +244,15 @@ int RateLimiter::check(ProcessingContext& ctx, int maxInFlight, size_t minSHM)
       mLastTime = std::chrono::system_clock::now();
       mTfTimes[mSentTimeframes % maxInFlight] = curTime;
     }
+    if (adaptive) {
+      mAdaptive.sent(mSentTimeframes, std::chrono::system_clock::now());
+    }
   }
   if (minSHM) {
     int waitMessage = 0;
     auto& runningWorkflow = ctx.services().get<RunningWorkflowInfo const>();
     while (true) {
-      long freeMemory = -1;
-      try {
-        freeMemory = fair::mq::shmem::Monitor::GetFreeMemory(fair::mq::shmem::ShmId{fair::mq::shmem::makeShmIdStr(device->fConfig->GetProperty<uint64_t>("shmid"))}, runningWorkflow.shmSegmentId);
-      } catch (...) {
-      }
-      if (freeMemory == -1) {
-        try {
-          freeMemory = fair::mq::shmem::Monitor::GetFreeMemory(fair::mq::shmem::SessionId{device->fConfig->GetProperty<std::string>("session")}, runningWorkflow.shmSegmentId);
-        } catch (...) {
-        }
-      }
+      long freeMemory = getFreeSHM(device, runningWorkflow);
       if (freeMemory == -1) {
         throw std::runtime_error("Could not obtain free SHM memory");
       }
@@ -9,6 +9,7 @@
 // granted to it by virtue of its status as an Intergovernmental Organization
 // or submit itself to any jurisdiction.
 #include "TextDriverClient.h"
+#include "Framework/DeviceMetricsHelper.h"
 #include "Framework/Logger.h"
 
 namespace o2::framework
@@ -20,6 +21,10 @@ TextDriverClient::TextDriverClient(ServiceRegistryRef registry, DeviceState& dev
 
 void TextDriverClient::tell(const char* msg, size_t s, bool flush)
 {
+  // Binary metrics only make sense for the driver, which has their ids.
+  if (DeviceMetricsHelper::isBinaryMetric(msg, s)) {
+    return;
+  }
   LOG(debug) << std::string_view{msg, s};
 }
 
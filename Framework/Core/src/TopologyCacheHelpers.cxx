@@ -0,0 +1,268 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#include "TopologyCacheHelpers.h"
+#include "DeviceSpecHelpers.h"
+
+#include <rapidjson/document.h>
+#include <rapidjson/istreamwrapper.h>
+#include <rapidjson/ostreamwrapper.h>
+#include <rapidjson/prettywriter.h>
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <regex>
+#include <sstream>
+#include <system_error>
+#include <unistd.h>
+
+namespace o2::framework
+{
+
+namespace
+{
+constexpr char const* WORKFLOW_ID_PLACEHOLDER = "{dpl-workflow-id}";
+
+std::string replaceAll(std::string s, std::string const& from, std::string const& to)
+{
+  size_t pos = 0;
+  while ((pos = s.find(from, pos)) != std::string::npos) {
+    s.replace(pos, from.size(), to);
+    pos += to.size();
+  }
+  return s;
+}
+
+/// Replace the workflow id with a placeholder. The id is normally a pid,
+/// in which case we only replace it when it is not part of a larger number.
+std::string hideWorkflowId(std::string const& s, std::string const& uniqueWorkflowId)
+{
+  if (uniqueWorkflowId.empty() || s.find(uniqueWorkflowId) == std::string::npos) {
+    return s;
+  }
+  if (!std::all_of(uniqueWorkflowId.begin(), uniqueWorkflowId.end(), ::isdigit)) {
+    return replaceAll(s, uniqueWorkflowId, WORKFLOW_ID_PLACEHOLDER);
+  }
+  return std::regex_replace(s, std::regex("(^|[^0-9])" + uniqueWorkflowId + "(?=[^0-9]|$)"), std::string("$1") + WORKFLOW_ID_PLACEHOLDER);
+}
+
+std::string restoreWorkflowId(std::string const& s, std::string const& uniqueWorkflowId)
+{
+  return replaceAll(s, WORKFLOW_ID_PLACEHOLDER, uniqueWorkflowId);
+}
+
+/// Modification time and size of @a executable, looked up in the PATH
+/// if needed. Empty if the executable cannot be found.
+std::string executableStamp(std::string const& executable)
+{
+  namespace fs = std::filesystem;
+  std::vector<fs::path> candidates;
+  if (executable.find('/') != std::string::npos) {
+    candidates.emplace_back(executable);
+  } else if (char const* path = getenv("PATH")) {
+    std::istringstream str{path};
+    std::string dir;
+    while (std::getline(str, dir, ':')) {
+      candidates.emplace_back(fs::path(dir) / executable);
+    }
+  }
+  for (auto& candidate : candidates) {
+    std::error_code ec;
+    auto size = fs::file_size(candidate, ec);
+    if (ec) {
+      continue;
+    }
+    auto mtime = fs::last_write_time(candidate, ec);
+    if (ec) {
+      continue;
+    }
+    return fmt::format("{}:{}:{}", candidate.string(), mtime.time_since_epoch().count(), size);
+  }
+  return "";
+}
+} // namespace
+
+std::string TopologyCacheHelpers::cacheFile(std::string const& key)
+{
+  char const* dir = getenv("DPL_TOPOLOGY_CACHE");
+  if (dir == nullptr || *dir == 0) {
+    return "";
+  }
+  return (std::filesystem::path(dir) / fmt::format("dpl-topology-{}.json", key)).string();
+}
+
+std::string TopologyCacheHelpers::cacheKey(std::vector<DeviceSpec> const& specs,
+                                           std::vector<DataProcessorInfo> const& infos,
+                                           std::string const& context,
+                                           std::string const& uniqueWorkflowId)
+{
+  std::ostringstream material;
+  for (auto& spec : specs) {
+    material << spec.id << "\n";
+    for (auto& channel : spec.inputChannels) {
+      material << DeviceSpecHelpers::inputChannel2String(channel) << "\n";
+    }
+    for (auto& channel : spec.outputChannels) {
+      material << DeviceSpecHelpers::outputChannel2String(channel) << "\n";
+    }
+    for (auto& option : spec.options) {
+      material << option.name << "=" << option.defaultValue << "\n";
+    }
+    material << spec.resource.cpuSet << "\n";
+  }
+  std::vector<std::string> executables;
+  for (auto& info : infos) {
+    material << info.name << " " << info.executable << "\n";
+    for (auto& arg : info.cmdLineArgs) {
+      material << arg << "\n";
+    }
+    if (std::find(executables.begin(), executables.end(), info.executable) == executables.end()) {
+      executables.push_back(info.executable);
+    }
+  }
+  for (auto& executable : executables) {
+    material << executableStamp(executable) << "\n";
+  }
+  // prepareArguments also picks these up from the environment of the driver
+  for (auto name : {"LD_PRELOAD", "DPL_SIGNPOSTS", "DPL_SIGNPOSTS_TRACE"}) {
+    char const* value = getenv(name);
+    material << name << "=" << (value ? value : "") << "\n";
+  }
+  material << context;
+  return fmt::format("{:016x}", std::hash<std::string>{}(hideWorkflowId(material.str(), uniqueWorkflowId)));
+}
+
+void TopologyCacheHelpers::save(std::ostream& out,
+                                std::string const& uniqueWorkflowId,
+                                std::vector<DeviceSpec> const& specs,
+                                std::vector<DeviceExecution> const& executions,
+                                std::vector<DeviceControl> const& controls)
+{
+  rapidjson::OStreamWrapper osw(out);
+  rapidjson::PrettyWriter<rapidjson::OStreamWrapper> w(osw);
+  auto writeString = [&w, &uniqueWorkflowId](char const* s) {
+    auto hidden = hideWorkflowId(s, uniqueWorkflowId);
+    w.String(hidden.c_str(), hidden.size());
+  };
+
+  w.StartObject();
+  w.Key("devices");
+  w.StartArray();
+  for (size_t di = 0; di < specs.size(); ++di) {
+    w.StartObject();
+    w.Key("id");
+    w.String(specs[di].id.c_str());
+    w.Key("args");
+    w.StartArray();
+    for (auto* arg : executions[di].args) {
+      // The list is terminated by a nullptr for execvp.
+      if (arg == nullptr) {
+        break;
+      }
+      writeString(arg);
+    }
+    w.EndArray();
+    w.Key("environ");
+    w.StartArray();
+    for (auto* env : executions[di].environ) {
+      writeString(env);
+    }
+    w.EndArray();
+    w.Key("options");
+    w.StartObject();
+    for (auto& [key, value] : controls[di].options) {
+      w.Key(key.c_str());
+      writeString(value.c_str());
+    }
+    w.EndObject();
+    w.EndObject();
+  }
+  w.EndArray();
+  w.EndObject();
+}
+
+void TopologyCacheHelpers::save(std::string const& filename,
+                                std::string const& uniqueWorkflowId,
+                                std::vector<DeviceSpec> const& specs,
+                                std::vector<DeviceExecution> const& executions,
+                                std::vector<DeviceControl> const& controls)
+{
+  // Concurrent invocations of the same workflow might be writing the same
+  // cache, so we never expose a partially written file.
+  auto tmp = fmt::format("{}.{}.tmp", filename, getpid());
+  {
+    std::ofstream out(tmp);
+    save(out, uniqueWorkflowId, specs, executions, controls);
+    if (!out.good()) {
+      std::error_code ec;
+      std::filesystem::remove(tmp, ec);
+      return;
+    }
+  }
+  std::error_code ec;
+  std::filesystem::rename(tmp, filename, ec);
+  if (ec) {
+    std::filesystem::remove(tmp, ec);
+  }
+}
+
+bool TopologyCacheHelpers::load(std::istream& in,
+                                std::string const& uniqueWorkflowId,
+                                std::vector<DeviceSpec> const& specs,
+                                std::vector<DeviceExecution>& executions,
+                                std::vector<DeviceControl>& controls)
+{
+  rapidjson::IStreamWrapper isw(in);
+  rapidjson::Document doc;
+  doc.ParseStream(isw);
+  if (doc.HasParseError() || !doc.IsObject() || !doc.HasMember("devices") || !doc["devices"].IsArray()) {
+    return false;
+  }
+  auto const& devices = doc["devices"];
+  if (devices.Size() != specs.size()) {
+    return false;
+  }
+  for (size_t di = 0; di < specs.size(); ++di) {
+    auto const& device = devices[static_cast<rapidjson::SizeType>(di)];
+    if (!device.IsObject() || !device.HasMember("id") || !device["id"].IsString() || specs[di].id != device["id"].GetString() ||
+        !device.HasMember("args") || !device.HasMember("environ") || !device.HasMember("options")) {
+      return false;
+    }
+  }
+
+  executions.resize(specs.size());
+  controls.resize(specs.size());
+  for (size_t di = 0; di < specs.size(); ++di) {
+    auto const& device = devices[static_cast<rapidjson::SizeType>(di)];
+    auto& execution = executions[di];
+    execution.args.clear();
+    execution.environ.clear();
+    for (auto const& arg : device["args"].GetArray()) {
+      execution.args.emplace_back(strdup(restoreWorkflowId(arg.GetString(), uniqueWorkflowId).c_str()));
+    }
+    // execvp wants a NULL terminated list.
+    execution.args.push_back(nullptr);
+    for (auto const& env : device["environ"].GetArray()) {
+      execution.environ.emplace_back(strdup(restoreWorkflowId(env.GetString(), uniqueWorkflowId).c_str()));
+    }
+    for (auto const& option : device["options"].GetObject()) {
+      controls[di].options[option.name.GetString()] = restoreWorkflowId(option.value.GetString(), uniqueWorkflowId);
+    }
+  }
+  return true;
+}
+
+} // namespace o2::framework
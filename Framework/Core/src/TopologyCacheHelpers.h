@@ -0,0 +1,75 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#ifndef O2_FRAMEWORK_TOPOLOGYCACHEHELPERS_H_
+#define O2_FRAMEWORK_TOPOLOGYCACHEHELPERS_H_
+
+#include "Framework/DeviceSpec.h"
+#include "Framework/DeviceControl.h"
+#include "Framework/DeviceExecution.h"
+#include "Framework/DataProcessorInfo.h"
+
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace o2::framework
+{
+
+/// Helpers to cache the resolved command line of every device of a
+/// topology, so that a restart of the same workflow with the same options
+/// does not need to go through the option parsing of all the devices again.
+///
+/// The id of the workflow, which is different for each invocation, is
+/// replaced by a placeholder both in the key and in the cached content.
+struct TopologyCacheHelpers {
+  /// @return the file where the cache for @a key is stored, or an empty
+  /// string if the DPL_TOPOLOGY_CACHE environment variable, which holds
+  /// the directory for the cache, is not set.
+  static std::string cacheFile(std::string const& key);
+
+  /// A key identifying the topology in @a specs, as built from
+  /// @a infos. @a context is any additional information the resolved
+  /// command line depends on, e.g. the serialised workflow and the
+  /// options of the driver. The executables involved are part of the
+  /// key as well, so that rebuilding them invalidates the cache, and so
+  /// are the environment variables the command line depends on.
+  static std::string cacheKey(std::vector<DeviceSpec> const& specs,
+                              std::vector<DataProcessorInfo> const& infos,
+                              std::string const& context,
+                              std::string const& uniqueWorkflowId);
+
+  static void save(std::ostream& out,
+                   std::string const& uniqueWorkflowId,
+                   std::vector<DeviceSpec> const& specs,
+                   std::vector<DeviceExecution> const& executions,
+                   std::vector<DeviceControl> const& controls);
+
+  /// Save the cache to @a filename, going through a temporary file so
+  /// that readers never see it partially written.
+  static void save(std::string const& filename,
+                   std::string const& uniqueWorkflowId,
+                   std::vector<DeviceSpec> const& specs,
+                   std::vector<DeviceExecution> const& executions,
+                   std::vector<DeviceControl> const& controls);
+
+  /// Fill @a executions and @a controls from the cache in @a in.
+  /// @return false if the cache cannot be used for @a specs.
+  static bool load(std::istream& in,
+                   std::string const& uniqueWorkflowId,
+                   std::vector<DeviceSpec> const& specs,
+                   std::vector<DeviceExecution>& executions,
+                   std::vector<DeviceControl>& controls);
+};
+
+} // namespace o2::framework
+
+#endif // O2_FRAMEWORK_TOPOLOGYCACHEHELPERS_H_
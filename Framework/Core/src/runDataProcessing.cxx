@@ -70,6 +70,8 @@
 #include "ArrowSupport.h"
 
 #include "ComputingResourceHelpers.h"
+#include "DevicePlacementHelpers.h"
+#include "TopologyCacheHelpers.h"
 #include "DataProcessingStatus.h"
 #include "DDSConfigHelpers.h"
 #include "O2ControlHelpers.h"
@@ -106,7 +108,9 @@
 #include <cstdlib>
 #include <cstring>
 #include <csignal>
+#include <fstream>
 #include <iostream>
+#include <iterator>
 #include <map>
 #include <regex>
 #include <set>
@@ -1017,6 +1021,58 @@ void doDefaultWorkflowTerminationHook()
   // LOG(info) << "Process " << getpid() << " is exiting.";
 }
 
+/// Dump the signposts recorded for the trace, if any, in dpl-trace-<name>.json
+void dumpSignpostsTrace(std::string const& name)
+{
+  if (_o2_signpost_trace_empty()) {
+    return;
+  }
+  auto filename = fmt::format("dpl-trace-{}.json", name);
+  FILE* out = fopen(filename.c_str(), "w");
+  if (out == nullptr) {
+    LOGP(warning, "Unable to dump signposts trace to {}", filename);
+    return;
+  }
+  auto count = _o2_signpost_trace_dump(out, getpid(), name.c_str());
+  fclose(out);
+  LOGP(info, "Dumped {} signposts to {}", count, filename);
+}
+
+/// Merge the traces of the driver and of all the devices in a single dpl-trace.json,
+/// which can be loaded in chrome://tracing or in Perfetto.
+void mergeSignpostsTraces(DeviceSpecs const& devices)
+{
+  dumpSignpostsTrace("driver");
+  std::vector<std::string> names{"driver"};
+  for (auto& device : devices) {
+    names.push_back(device.id);
+  }
+  std::ofstream merged("dpl-trace.json", std::ios::out);
+  if (!merged.is_open()) {
+    LOGP(warning, "Unable to write dpl-trace.json");
+    return;
+  }
+  // Each file is a JSON array: we strip the brackets and join the events.
+  bool first = true;
+  merged << "[";
+  for (auto& name : names) {
+    std::ifstream in(fmt::format("dpl-trace-{}.json", name));
+    if (!in.is_open()) {
+      continue;
+    }
+    std::string content{std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+    auto begin = content.find('[');
+    auto end = content.rfind(']');
+    if (begin == std::string::npos || end == std::string::npos || end <= begin + 1) {
+      continue;
+    }
+    merged << (first ? "" : ",\n") << std::string_view(content).substr(begin + 1, end - begin - 1);
+    first = false;
+  }
+  merged << "]\n";
+  LOGP(info, "Merged signposts traces of {} processes in dpl-trace.json", names.size());
+}
+
 int doChild(int argc, char** argv, ServiceRegistry& serviceRegistry,
             RunningWorkflowInfo const& runningWorkflow,
             RunningDeviceRef ref,
@@ -1047,15 +1103,18 @@ int doChild(int argc, char** argv, ServiceRegistry& serviceRegistry,
     boost::program_options::options_description optsDesc;
     ConfigParamsHelper::populateBoostProgramOptions(optsDesc, spec.options, gHiddenDeviceOptions);
     char const* defaultSignposts = getenv("DPL_SIGNPOSTS");
+    char const* defaultSignpostsTrace = getenv("DPL_SIGNPOSTS_TRACE");
     optsDesc.add_options()("monitoring-backend", bpo::value<std::string>()->default_value("default"), "monitoring backend info")                                                           //
       ("driver-client-backend", bpo::value<std::string>()->default_value(defaultDriverClient), "backend for device -> driver communicataon: stdout://: use stdout, ws://: use websockets") //
       ("infologger-severity", bpo::value<std::string>()->default_value(""), "minimum FairLogger severity to send to InfoLogger")                                                           //
       ("dpl-tracing-flags", bpo::value<std::string>()->default_value(""), "pipe `|` separate list of events to be traced")                                                                 //
       ("signposts", bpo::value<std::string>()->default_value(defaultSignposts ? defaultSignposts : ""), "comma separated list of signposts to enable")                                     //
+      ("signposts-trace", bpo::value<std::string>()->default_value(defaultSignpostsTrace ? defaultSignpostsTrace : ""), "comma separated list of signposts to record in a trace")          //
       ("expected-region-callbacks", bpo::value<std::string>()->default_value("0"), "how many region callbacks we are expecting")                                                           //
       ("exit-transition-timeout", bpo::value<std::string>()->default_value(defaultExitTransitionTimeout), "how many second to wait before switching from RUN to READY")                    //
       ("timeframes-rate-limit", bpo::value<std::string>()->default_value("0"), "how many timeframe can be in fly at the same moment (0 disables)")                                         //
       ("configuration,cfg", bpo::value<std::string>()->default_value("command-line"), "configuration backend")                                                                             //
+      ("cpu-affinity", bpo::value<std::string>()->default_value(""), "CPUs the device and its threads are pinned to")                                                                     //
       ("infologger-mode", bpo::value<std::string>()->default_value(defaultInfologgerMode), "O2_INFOLOGGER_MODE override");
     r.fConfig.AddToCmdLineOptions(optsDesc, true);
   });
@@ -1080,6 +1139,12 @@ int doChild(int argc, char** argv, ServiceRegistry& serviceRegistry,
                                      &deviceContext,
                                      &driverConfig,
                                      &loop](fair::mq::DeviceRunner& r) {
+    // Pin before anything else, so that all the threads created
+    // afterwards inherit the affinity.
+    auto cpuAffinity = r.fConfig.GetPropertyAsString("cpu-affinity");
+    if (!cpuAffinity.empty() && !DevicePlacementHelpers::applyCpuAffinity(cpuAffinity)) {
+      LOGP(warning, "Unable to pin {} to CPUs {}", spec.id, cpuAffinity);
+    }
     ServiceRegistryRef serviceRef = {serviceRegistry};
     simpleRawDeviceService = std::make_unique<SimpleRawDeviceService>(nullptr, spec);
     serviceRef.registerService(ServiceRegistryHelpers::handleForService<RawDeviceService>(simpleRawDeviceService.get()));
@@ -1123,6 +1188,7 @@ int doChild(int argc, char** argv, ServiceRegistry& serviceRegistry,
   ServiceRegistryRef serviceRef = {serviceRegistry};
   auto& context = serviceRef.get<DataProcessorContext>();
   DataProcessorContext::preExitCallbacks(context.preExitHandles, serviceRef);
+  dumpSignpostsTrace(spec.id);
   return result;
 }
 
@@ -1759,6 +1825,13 @@ int runStateMachine(DataProcessorSpecs const& workflow,
                                                             driverInfo.resourcesMonitoringInterval,
                                                             varmap["channel-prefix"].as<std::string>(),
                                                             overrides);
+          auto placementMode = DevicePlacementHelpers::parsePlacementMode(varmap["numa-placement"].as<std::string>());
+          if (placementMode != DevicePlacementMode::None) {
+            DevicePlacementHelpers::computePlacement(runningWorkflow.devices, DevicePlacementHelpers::readTopology(), placementMode);
+            for (auto& device : runningWorkflow.devices) {
+              LOGP(info, "{} placed on NUMA node {}, CPUs {}", device.id, device.resource.numaNode, device.resource.cpuSet);
+            }
+          }
           metricProcessingCallbacks.clear();
           std::vector<std::string> matchingServices;
 
@@ -1840,6 +1913,11 @@ int runStateMachine(DataProcessorSpecs const& workflow,
             if (device.name.find("internal") != std::string::npos) {
               continue;
             }
+            // a child only needs its own options, the others were
+            // already resolved by the driver.
+            if (!frameworkId.empty() && device.id != frameworkId) {
+              continue;
+            }
             auto configStore = DeviceConfigurationHelpers::getConfiguration(serviceRegistry, device.name.c_str(), device.options);
             if (configStore != nullptr) {
               auto reg = std::make_unique<ConfigParamRegistry>(std::move(configStore));
@@ -2042,17 +2120,53 @@ int runStateMachine(DataProcessorSpecs const& workflow,
           }
 
           DeviceSpecHelpers::reworkShmSegmentSize(dataProcessorInfos);
-          DeviceSpecHelpers::prepareArguments(driverControl.defaultQuiet,
-                                              driverControl.defaultStopped,
-                                              driverInfo.processingPolicies.termination == TerminationPolicy::WAIT,
-                                              driverInfo.port,
-                                              driverConfig,
-                                              dataProcessorInfos,
-                                              runningWorkflow.devices,
-                                              deviceExecutions,
-                                              controls,
-                                              detectedParams,
-                                              driverInfo.uniqueWorkflowId);
+
+          // Children only need their own DeviceSpec, the command lines
+          // are only needed by the driver to spawn them.
+          if (!frameworkId.empty()) {
+            break;
+          }
+          // Resolving the command line of each device is expensive for
+          // large topologies, so we reuse the one of a previous invocation
+          // if nothing changed.
+          std::string topologyCache;
+          if (getenv("DPL_TOPOLOGY_CACHE")) {
+            std::ostringstream context;
+            WorkflowSerializationHelpers::dump(context, workflow, dataProcessorInfos, commandInfo);
+            context << driverControl.defaultQuiet << driverControl.defaultStopped
+                    << (driverInfo.processingPolicies.termination == TerminationPolicy::WAIT)
+                    << driverInfo.port << driverConfig.batch << driverConfig.driverHasGUI << "\n";
+            for (auto& param : detectedParams) {
+              context << param.name << "=" << param.defaultValue << "\n";
+            }
+            topologyCache = TopologyCacheHelpers::cacheFile(TopologyCacheHelpers::cacheKey(runningWorkflow.devices, dataProcessorInfos, context.str(), driverInfo.uniqueWorkflowId));
+          }
+          std::ifstream cached;
+          if (!topologyCache.empty()) {
+            cached.open(topologyCache);
+          }
+          if (cached.is_open() && TopologyCacheHelpers::load(cached, driverInfo.uniqueWorkflowId, runningWorkflow.devices, deviceExecutions, controls)) {
+            LOGP(info, "Device configuration loaded from {}", topologyCache);
+            for (auto& control : controls) {
+              control.quiet = driverControl.defaultQuiet;
+              control.stopped = driverControl.defaultStopped;
+            }
+          } else {
+            DeviceSpecHelpers::prepareArguments(driverControl.defaultQuiet,
+                                                driverControl.defaultStopped,
+                                                driverInfo.processingPolicies.termination == TerminationPolicy::WAIT,
+                                                driverInfo.port,
+                                                driverConfig,
+                                                dataProcessorInfos,
+                                                runningWorkflow.devices,
+                                                deviceExecutions,
+                                                controls,
+                                                detectedParams,
+                                                driverInfo.uniqueWorkflowId);
+            if (!topologyCache.empty()) {
+              TopologyCacheHelpers::save(topologyCache, driverInfo.uniqueWorkflowId, runningWorkflow.devices, deviceExecutions, controls);
+            }
+          }
         } catch (o2::framework::RuntimeErrorRef& ref) {
           auto& err = o2::framework::error_from_ref(ref);
           LOGP(error, "unable to merge configurations in {}: {}", driverInfo.argv[0], err.what);
@@ -2233,6 +2347,9 @@ int runStateMachine(DataProcessorSpecs const& workflow,
           dumpMetricsCallback(&metricDumpTimer);
         }
         dumpRunSummary(serverContext, driverInfo, infos, runningWorkflow.devices);
+        if (driverInfo.signpostsTrace) {
+          mergeSignpostsTraces(runningWorkflow.devices);
+        }
         // This is a clean exit. Before we do so, if required,
         // we dump the configuration of all the devices so that
         // we can reuse it. Notice we do not dump anything if
@@ -2793,7 +2910,8 @@ int doMain(int argc, char** argv, o2::framework::WorkflowSpec const& workflow,
     ("no-IPC", bpo::value<bool>()->zero_tokens()->default_value(false), "disable IPC topology optimization")                                                           //                                                                                                                                        //
     ("o2-control,o2", bpo::value<std::string>()->default_value(""), "dump O2 Control workflow configuration under the specified name")                                 //
     ("resources-monitoring", bpo::value<unsigned short>()->default_value(0), "enable cpu/memory monitoring for provided interval in seconds")                          //
-    ("resources-monitoring-dump-interval", bpo::value<unsigned short>()->default_value(0), "dump monitoring information to disk every provided seconds");              //
+    ("resources-monitoring-dump-interval", bpo::value<unsigned short>()->default_value(0), "dump monitoring information to disk every provided seconds")               //
+    ("numa-placement", bpo::value<std::string>()->default_value("none"), "pin devices to the NUMA nodes of the host: none, node, core");                               //
   // some of the options must be forwarded by default to the device
   executorOptions.add(DeviceSpecHelpers::getForwardedDeviceOptions());
 
@@ -2801,6 +2919,7 @@ int doMain(int argc, char** argv, o2::framework::WorkflowSpec const& workflow,
     ("id,i", bpo::value<std::string>(), "device id for child spawning")                 //
     ("channel-config", bpo::value<std::vector<std::string>>(), "channel configuration") //
     ("control", "control plugin")                                                       //
+    ("cpu-affinity", bpo::value<std::string>(), "CPUs the device is pinned to")        //
     ("log-color", "logging color scheme")("color", "logging color scheme");
 
   bpo::options_description visibleOptions;
@@ -3079,7 +3198,31 @@ int doMain(int argc, char** argv, o2::framework::WorkflowSpec const& workflow,
       o2_walk_logs(matchingLogEnabler, token);
       token = strtok_r(nullptr, ",", &saveptr);
     }
-  } else {
+  }
+  bool signpostsTrace = false;
+  if (varmap.count("signposts-trace")) {
+    auto signpostsToTrace = varmap["signposts-trace"].as<std::string>();
+    auto matchingLogTracer = [](char const* name, void* l, void* context) {
+      auto* log = (_o2_log_t*)l;
+      auto* selectedName = (char const*)context;
+      std::string prefix = "ch.cern.aliceo2.";
+      if (strcmp(name, (prefix + selectedName).data()) == 0) {
+        LOGP(info, "Recording signposts for stream \"ch.cern.aliceo2.{}\" in the trace", selectedName);
+        _o2_log_set_trace(log, 1);
+        return false;
+      }
+      return true;
+    };
+    char* saveptr;
+    char* src = const_cast<char*>(signpostsToTrace.data());
+    auto* token = strtok_r(src, ",", &saveptr);
+    while (token) {
+      signpostsTrace = true;
+      o2_walk_logs(matchingLogTracer, token);
+      token = strtok_r(nullptr, ",", &saveptr);
+    }
+  }
+  if (varmap.count("signposts") == 0) {
     auto printAllSignposts = [](char const* name, void* l, void* context) {
       auto* log = (_o2_log_t*)l;
       LOGP(detail, "Signpost stream {} disabled. Enable it with o2-log -p {} -a {}", name, pid, (void*)&log->stacktrace);
@@ -3117,6 +3260,7 @@ int doMain(int argc, char** argv, o2::framework::WorkflowSpec const& workflow,
   driverInfo.argc = argc;
   driverInfo.argv = argv;
   driverInfo.noSHMCleanup = varmap["no-cleanup"].as<bool>();
+  driverInfo.signpostsTrace = signpostsTrace;
   driverInfo.processingPolicies.termination = varmap["completion-policy"].as<TerminationPolicy>();
   driverInfo.processingPolicies.earlyForward = varmap["early-forward-policy"].as<EarlyForwardPolicy>();
   driverInfo.mode = varmap["driver-mode"].as<DriverMode>();
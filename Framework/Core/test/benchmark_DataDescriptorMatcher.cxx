@@ -11,6 +11,9 @@
 #include <benchmark/benchmark.h>
 #include "Headers/DataHeader.h"
 #include "Framework/DataDescriptorMatcher.h"
+#include "Framework/DataProcessingHeader.h"
+#include "Headers/Stack.h"
+#include <cstdio>
 
 using namespace o2::header;
 using namespace o2::framework::data_matcher;
@@ -179,4 +182,72 @@ static void BM_OneVariableMatchUnmatch(benchmark::State& state)
 // Register the function as a benchmark
 BENCHMARK(BM_OneVariableMatchUnmatch);
 
+// Routing a message among many routes, as done by the DataRelayer, either
+// trying each route in turn or only the candidates given by the index.
+static void BM_RouteManyMatchers(benchmark::State& state)
+{
+  auto nRoutes = state.range(0);
+  bool indexed = state.range(1);
+
+  std::vector<DataDescriptorMatcher> matchers;
+  DataDescriptorMatcherIndex index;
+  for (int i = 0; i < nRoutes; ++i) {
+    char description[16];
+    snprintf(description, 16, "DATA%d", i);
+    matchers.emplace_back(DataDescriptorMatcher::Op::And,
+                          OriginValueMatcher{"TST"},
+                          std::make_unique<DataDescriptorMatcher>(
+                            DataDescriptorMatcher::Op::And,
+                            DescriptionValueMatcher{description},
+                            std::make_unique<DataDescriptorMatcher>(
+                              DataDescriptorMatcher::Op::And,
+                              SubSpecificationTypeValueMatcher{0},
+                              StartTimeValueMatcher{ContextRef{0}})));
+    index.add(i, matchers.back());
+  }
+  // A wildcard route at the end, which is always a candidate.
+  matchers.emplace_back(DataDescriptorMatcher::Op::And,
+                        OriginValueMatcher{"TST"},
+                        std::make_unique<DataDescriptorMatcher>(
+                          DataDescriptorMatcher::Op::And,
+                          DescriptionValueMatcher{ContextRef{1}},
+                          StartTimeValueMatcher{ContextRef{0}}));
+  index.add(nRoutes, matchers.back());
+
+  DataHeader header;
+  header.dataOrigin = "TST";
+  char description[16];
+  snprintf(description, 16, "DATA%d", (int)nRoutes - 1);
+  header.dataDescription = description;
+  header.subSpecification = 0;
+  o2::framework::DataProcessingHeader dph{0, 1};
+  Stack stack{header, dph};
+
+  VariableContext context;
+
+  for (auto _ : state) {
+    int pos = -1;
+    if (indexed) {
+      pos = index.find(header, [&](int ri) {
+        if (matchers[ri].match(stack, context)) {
+          return true;
+        }
+        context.discard();
+        return false;
+      });
+    } else {
+      for (size_t ri = 0; ri < matchers.size(); ++ri) {
+        if (matchers[ri].match(stack, context)) {
+          pos = ri;
+          break;
+        }
+        context.discard();
+      }
+    }
+    benchmark::DoNotOptimize(pos);
+    context.discard();
+  }
+}
+BENCHMARK(BM_RouteManyMatchers)->ArgsProduct({{4, 32, 256}, {0, 1}});
+
 BENCHMARK_MAIN();
@@ -103,4 +103,57 @@ static void BM_InputRecordGenericGetters(benchmark::State& state)
 
 BENCHMARK(BM_InputRecordGenericGetters);
 
+// Lookup by binding in a record with many inputs, like the ones of
+// reconstruction devices. The binding we look for is the last one.
+static void BM_InputRecordManyInputs(benchmark::State& state)
+{
+  size_t nInputs = state.range(0);
+  std::vector<InputRoute> schema;
+  std::vector<std::string> bindings;
+  for (size_t i = 0; i < nInputs; ++i) {
+    bindings.push_back(i == nInputs - 1 ? "lastinput" : "input" + std::to_string(i));
+  }
+  for (size_t i = 0; i < nInputs; ++i) {
+    InputSpec spec{bindings[i], "TST", "DATA", static_cast<o2::header::DataHeader::SubSpecificationType>(i), Lifetime::Timeframe};
+    schema.emplace_back(InputRoute{spec, i, "source"});
+  }
+
+  DataHeader dh;
+  dh.dataDescription = "DATA";
+  dh.dataOrigin = "TST";
+  dh.payloadSerializationMethod = o2::header::gSerializationMethodNone;
+  DataProcessingHeader dph{0, 1};
+  Stack stack{dh, dph};
+  int value = 1;
+  InputSpan span{[&stack, &value](size_t) { return DataRef{nullptr, reinterpret_cast<char const*>(stack.data()), reinterpret_cast<char const*>(&value)}; }, nInputs};
+  ServiceRegistry registry;
+  InputRecord record{schema, span, registry};
+
+  bool hashed = state.range(1);
+  for (auto _ : state) {
+    if (hashed) {
+      benchmark::DoNotOptimize(record.get(BINDING("lastinput")));
+    } else {
+      benchmark::DoNotOptimize(record.get("lastinput"));
+    }
+  }
+}
+
+BENCHMARK(BM_InputRecordManyInputs)->ArgsProduct({{4, 16, 64}, {0, 1}});
+
+// Cost of building the lookup tables, which is paid once per device
+static void BM_InputRecordBuildIndex(benchmark::State& state)
+{
+  std::vector<InputRoute> schema;
+  for (int64_t i = 0; i < state.range(0); ++i) {
+    InputSpec spec{"input" + std::to_string(i), "TST", "DATA", static_cast<o2::header::DataHeader::SubSpecificationType>(i), Lifetime::Timeframe};
+    schema.emplace_back(InputRoute{spec, static_cast<size_t>(i), "source"});
+  }
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(InputRecord::buildIndex(schema));
+  }
+}
+
+BENCHMARK(BM_InputRecordBuildIndex)->Arg(4)->Arg(16)->Arg(64);
+
 BENCHMARK_MAIN();
@@ -0,0 +1,92 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+#include "Framework/ConfigParamSpec.h"
+#include "Framework/ControlService.h"
+#include "Framework/CallbackService.h"
+#include "Framework/EndOfStreamContext.h"
+#include "Framework/Logger.h"
+#include "Framework/runDataProcessing.h"
+
+#include <chrono>
+#include <mutex>
+#include <set>
+#include <thread>
+
+using namespace o2::framework;
+
+namespace
+{
+constexpr int nTimeslices = 32;
+}
+
+// The processor handles the timeslices on more than one stream. Earlier
+// timeslices take longer, so that without ordering the later ones would
+// overtake them. The consumer checks that nothing is lost and that the
+// outputs still arrive in order.
+WorkflowSpec defineDataProcessing(ConfigContext const&)
+{
+  return WorkflowSpec{
+    {"producer",
+     {},
+     {OutputSpec{"TST", "A", 0}},
+     AlgorithmSpec{adaptStateless([](DataAllocator& outputs, ControlService& control) {
+       static int counter = 0;
+       outputs.make<int>(Output{"TST", "A", 0}) = counter++;
+       if (counter == nTimeslices) {
+         control.endOfStream();
+         control.readyToQuit(QuitRequest::Me);
+       }
+     })}},
+    {"processor",
+     {InputSpec{"a", "TST", "A", 0}},
+     {OutputSpec{"TST", "B", 0}},
+     AlgorithmSpec{adaptStateful([](CallbackService& callbacks) {
+       static std::mutex mutex;
+       static std::set<std::thread::id> threads;
+       callbacks.set<CallbackService::Id::EndOfStream>([](EndOfStreamContext&) {
+         std::scoped_lock<std::mutex> lock(mutex);
+         if (threads.size() < 2) {
+           LOG(error) << "Expecting the processing on more than one thread, found " << threads.size();
+         }
+       });
+       return adaptStateless([](InputRecord& inputs, DataAllocator& outputs) {
+         auto value = inputs.get<int>("a");
+         std::this_thread::sleep_for(std::chrono::milliseconds(2 * (nTimeslices - value)));
+         {
+           std::scoped_lock<std::mutex> lock(mutex);
+           threads.insert(std::this_thread::get_id());
+         }
+         outputs.make<int>(Output{"TST", "B", 0}) = value;
+       });
+     })},
+     {ConfigParamSpec{"dpl-streams", VariantType::Int, 4, {"Number of concurrent streams"}}}},
+    {"consumer",
+     {InputSpec{"b", "TST", "B", 0}},
+     {},
+     AlgorithmSpec{adaptStateful([](CallbackService& callbacks) {
+       static int expected = 0;
+       callbacks.set<CallbackService::Id::EndOfStream>([](EndOfStreamContext&) {
+         if (expected != nTimeslices) {
+           LOG(error) << "Expecting " << nTimeslices << " timeslices, got " << expected;
+         }
+       });
+       return adaptStateless([](InputRecord& inputs, ControlService& control) {
+         auto value = inputs.get<int>("b");
+         if (value != expected) {
+           LOG(error) << "Expecting " << expected << " found " << value;
+         }
+         expected = value + 1;
+         if (expected == nTimeslices) {
+           control.readyToQuit(QuitRequest::All);
+         }
+       });
+     })}}};
+}
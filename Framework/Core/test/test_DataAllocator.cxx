@@ -13,6 +13,7 @@
 #include "Framework/WorkflowSpec.h"
 #include "Framework/DataProcessorSpec.h"
 #include "Framework/RootMessageContext.h"
+#include "Framework/MessageContext.h"
 #include "Framework/runDataProcessing.h"
 #include "Framework/DataAllocator.h"
 #include "Framework/InputRecord.h"
@@ -90,6 +91,14 @@ DataProcessorSpec getSourceSpec()
     // class Polymorphic is not messageable, so the serialization type is deduced
     // from the fact that the type has a dictionary and can be ROOT-serialized.
     pc.outputs().snapshot(Output{"TST", "ROOTNONTOBJECT", 0}, b);
+    // ROOT serialized object whose serialized buffer is kept for reuse
+    static o2::test::Polymorphic cached(0xcafe);
+    pc.outputs().snapshot(Output{"TST", "ROOTCACHED", 0}, cached, DataAllocator::SerializationVersion{1});
+    pc.outputs().snapshot(Output{"TST", "ROOTCACHED", 1}, cached, DataAllocator::SerializationVersion{1});
+    // the second snapshot must not have serialized the object again
+    auto& messageContext = pc.services().get<MessageContext>();
+    ASSERT_ERROR(messageContext.findMessagePayload(Output{"TST", "ROOTCACHED", 0}) != nullptr);
+    ASSERT_ERROR(messageContext.findMessagePayload(Output{"TST", "ROOTCACHED", 0}) == messageContext.findMessagePayload(Output{"TST", "ROOTCACHED", 1}));
     // vector of ROOT serializable class
     pc.outputs().snapshot(Output{"TST", "ROOTVECTOR", 0}, c);
     // deque of simple types
@@ -185,6 +194,8 @@ DataProcessorSpec getSourceSpec()
                             OutputSpec{"TST", "ADOPTCHUNK", 0, Lifetime::Timeframe},
                             OutputSpec{"TST", "MSGBLEROOTSRLZ", 0, Lifetime::Timeframe},
                             OutputSpec{"TST", "ROOTNONTOBJECT", 0, Lifetime::Timeframe},
+                            OutputSpec{"TST", "ROOTCACHED", 0, Lifetime::Timeframe},
+                            OutputSpec{"TST", "ROOTCACHED", 1, Lifetime::Timeframe},
                             OutputSpec{"TST", "ROOTVECTOR", 0, Lifetime::Timeframe},
                             OutputSpec{"TST", "DEQUE", 0, Lifetime::Timeframe},
                             OutputSpec{"TST", "ROOTSERLZDVEC", 0, Lifetime::Timeframe},
@@ -259,6 +270,13 @@ DataProcessorSpec getSinkSpec()
     ASSERT_ERROR(object3 != nullptr);
     ASSERT_ERROR(*object3 == o2::test::Polymorphic(0xbeef));
 
+    auto cached = pc.inputs().get<o2::test::Polymorphic*>("cached");
+    ASSERT_ERROR(cached != nullptr);
+    ASSERT_ERROR(*cached == o2::test::Polymorphic(0xcafe));
+    auto cachedAgain = pc.inputs().get<o2::test::Polymorphic*>("cachedAgain");
+    ASSERT_ERROR(cachedAgain != nullptr);
+    ASSERT_ERROR(*cachedAgain == o2::test::Polymorphic(0xcafe));
+
     // container of objects
     LOG(info) << "extracting vector of o2::test::Polymorphic from input4";
     auto object4 = pc.inputs().get<std::vector<o2::test::Polymorphic>>("input4");
@@ -370,6 +388,8 @@ DataProcessorSpec getSinkSpec()
                            {InputSpec{"input1", "TST", "MESSAGEABLE", 0, Lifetime::Timeframe},
                             InputSpec{"input2", "TST", "MSGBLEROOTSRLZ", 0, Lifetime::Timeframe},
                             InputSpec{"input3", "TST", "ROOTNONTOBJECT", 0, Lifetime::Timeframe},
+                            InputSpec{"cached", "TST", "ROOTCACHED", 0, Lifetime::Timeframe},
+                            InputSpec{"cachedAgain", "TST", "ROOTCACHED", 1, Lifetime::Timeframe},
                             InputSpec{"input4", "TST", "ROOTVECTOR", 0, Lifetime::Timeframe},
                             InputSpec{"input5", "TST", "ROOTSERLZDVEC", 0, Lifetime::Timeframe},
                             InputSpec{"input6", "TST", "ROOTSERLZDVEC2", 0, Lifetime::Timeframe},
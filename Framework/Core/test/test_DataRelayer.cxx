@@ -114,6 +114,56 @@ TEST_CASE("DataRelayer")
     REQUIRE(result.at(0).size() == 1);
   }
 
+  // When more than one stream processes the data, a slot which was
+  // handed out is not handed out again until it is released.
+  SECTION("TestClaimSlots")
+  {
+    InputSpec spec{"clusters", "TPC", "CLUSTERS"};
+
+    std::vector<InputRoute> inputs = {
+      InputRoute{spec, 0, "Fake", 0}};
+
+    std::vector<InputChannelInfo> infos{1};
+    TimesliceIndex index{1, infos};
+    ref.registerService(ServiceRegistryHelpers::handleForService<TimesliceIndex>(&index));
+
+    auto policy = CompletionPolicyHelpers::processWhenAny();
+    DataRelayer relayer(policy, inputs, index, {registry});
+    relayer.setPipelineLength(4);
+    relayer.setClaimSlots(true);
+
+    DataHeader dh;
+    dh.dataDescription = "CLUSTERS";
+    dh.dataOrigin = "TPC";
+    dh.subSpecification = 0;
+    dh.splitPayloadIndex = 0;
+    dh.splitPayloadParts = 1;
+
+    DataProcessingHeader dph{0, 1};
+    auto transport = fair::mq::TransportFactory::CreateTransportFactory("zeromq");
+    std::array<fair::mq::MessagePtr, 2> messages;
+    auto channelAlloc = o2::pmr::getTransportAllocator(transport.get());
+    messages[0] = o2::pmr::getMessage(Stack{channelAlloc, dh, dph});
+    messages[1] = transport->CreateMessage(1000);
+    DataRelayer::InputInfo fakeInfo{0, messages.size(), DataRelayer::InputType::Data, {ChannelIndex::INVALID}};
+    relayer.relay(messages[0]->GetData(), messages.data(), fakeInfo, messages.size());
+    std::vector<RecordAction> ready;
+    relayer.getReadyToProcess(ready);
+    REQUIRE(ready.size() == 1);
+    REQUIRE(ready[0].op == CompletionPolicy::CompletionOp::Process);
+
+    // The data is still there, but another stream is working on it.
+    relayer.rescan();
+    std::vector<RecordAction> other;
+    relayer.getReadyToProcess(other);
+    REQUIRE(other.empty());
+
+    relayer.releaseSlot(ready[0].slot);
+    relayer.getReadyToProcess(other);
+    REQUIRE(other.size() == 1);
+    REQUIRE(other[0].slot.index == ready[0].slot.index);
+  }
+
   //
   SECTION("TestNoWaitMatcher")
   {
@@ -515,3 +515,40 @@ TEST_CASE("TestHelpers")
   REQUIRE(metric2 == 0);
   REQUIRE(metric3 == 1);
 }
+
+TEST_CASE("TestBinaryMetrics")
+{
+  using namespace o2::framework;
+  DeviceMetricsInfo info;
+  ParsedMetricMatch match;
+  std::string metricString = "[METRIC] bkey,0 12 1789372894 hostname=test.cern.ch";
+  REQUIRE(DeviceMetricsHelper::parseMetric(metricString, match));
+  REQUIRE(DeviceMetricsHelper::processMetric(match, info));
+
+  uint32_t id = -1;
+  std::string_view name;
+  REQUIRE(DeviceMetricsHelper::parseMetricId("[METRIC_ID] 3 bkey", id, name));
+  REQUIRE(id == 3);
+  REQUIRE(name == "bkey");
+  REQUIRE(DeviceMetricsHelper::parseMetricId("[METRIC] bkey,0 12 1789372894", id, name) == false);
+  REQUIRE(DeviceMetricsHelper::parseMetricId("[METRIC_ID] 3", id, name) == false);
+
+  BinaryMetric metric;
+  metric.id = id;
+  metric.type = MetricType::Int;
+  metric.intValue = 13;
+  metric.timestamp = 1789372895;
+  REQUIRE(DeviceMetricsHelper::isBinaryMetric(reinterpret_cast<char const*>(&metric), sizeof(metric)));
+  REQUIRE(DeviceMetricsHelper::isBinaryMetric(metricString.data(), metricString.size()) == false);
+
+  auto metricIndex = DeviceMetricsHelper::metricIdxByName("bkey", info);
+  REQUIRE(metricIndex == 0);
+  REQUIRE(DeviceMetricsHelper::processBinaryMetric(metric, metricIndex, info));
+  REQUIRE(info.metrics[0].filledMetrics == 2);
+  REQUIRE(info.intMetrics[0][0] == 12);
+  REQUIRE(info.intMetrics[0][1] == 13);
+  REQUIRE(info.intTimestamps[0][1] == 1789372895);
+  REQUIRE(info.max[0] == 13);
+  REQUIRE(info.min[0] == 12);
+  REQUIRE(DeviceMetricsHelper::processBinaryMetric(metric, 1, info) == false);
+}
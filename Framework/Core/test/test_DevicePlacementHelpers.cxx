@@ -0,0 +1,112 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#include <catch_amalgamated.hpp>
+
+#include "../src/DevicePlacementHelpers.h"
+#include <string>
+#include <vector>
+
+using namespace o2::framework;
+
+namespace
+{
+DeviceSpec makeDevice(std::string const& name, std::vector<std::string> const& inputs, std::vector<std::string> const& outputs)
+{
+  DeviceSpec spec;
+  spec.name = name;
+  spec.id = name;
+  for (auto& input : inputs) {
+    InputChannelSpec channel;
+    channel.name = input;
+    spec.inputChannels.push_back(channel);
+  }
+  for (auto& output : outputs) {
+    spec.outputs.push_back(OutputRoute{0, 1, OutputSpec{"TST", "A"}, output, nullptr});
+  }
+  return spec;
+}
+} // namespace
+
+TEST_CASE("TestCpuListParsing")
+{
+  REQUIRE(DevicePlacementHelpers::parseCpuList("0-3,8,10-11") == std::vector<int>{0, 1, 2, 3, 8, 10, 11});
+  REQUIRE(DevicePlacementHelpers::parseCpuList("").empty());
+  REQUIRE(DevicePlacementHelpers::formatCpuList({0, 1, 2, 3, 8, 10, 11}) == "0-3,8,10-11");
+  REQUIRE(DevicePlacementHelpers::formatCpuList({5}) == "5");
+  REQUIRE(DevicePlacementHelpers::parsePlacementMode("none") == DevicePlacementMode::None);
+  REQUIRE(DevicePlacementHelpers::parsePlacementMode("node") == DevicePlacementMode::Node);
+  REQUIRE(DevicePlacementHelpers::parsePlacementMode("core") == DevicePlacementMode::Core);
+}
+
+TEST_CASE("TestPlacementFollowsEdges")
+{
+  std::vector<NumaNodeInfo> nodes{{0, {0, 1, 2, 3}, 0}, {1, {4, 5, 6, 7}, 1}};
+  // Two independent chains: A -> B and C -> D
+  std::vector<DeviceSpec> devices{
+    makeDevice("A", {}, {"from_A_to_B", "from_A_to_B"}),
+    makeDevice("C", {}, {"from_C_to_D"}),
+    makeDevice("B", {"from_A_to_B"}, {}),
+    makeDevice("D", {"from_C_to_D"}, {})};
+
+  DevicePlacementHelpers::computePlacement(devices, nodes, DevicePlacementMode::None);
+  for (auto& device : devices) {
+    REQUIRE(device.resource.numaNode == -1);
+    REQUIRE(device.resource.cpuSet.empty());
+  }
+
+  DevicePlacementHelpers::computePlacement(devices, nodes, DevicePlacementMode::Node);
+  REQUIRE(devices[0].resource.numaNode == devices[2].resource.numaNode);
+  REQUIRE(devices[1].resource.numaNode == devices[3].resource.numaNode);
+  REQUIRE(devices[0].resource.numaNode != devices[1].resource.numaNode);
+  for (auto& device : devices) {
+    REQUIRE(device.resource.cpuSet == (device.resource.numaNode == 0 ? "0-3" : "4-7"));
+  }
+
+  DevicePlacementHelpers::computePlacement(devices, nodes, DevicePlacementMode::Core);
+  REQUIRE(devices[0].resource.numaNode == devices[2].resource.numaNode);
+  REQUIRE(devices[0].resource.cpuSet != devices[2].resource.cpuSet);
+  REQUIRE(DevicePlacementHelpers::parseCpuList(devices[0].resource.cpuSet).size() == 2);
+}
+
+TEST_CASE("TestPlacementAffinity")
+{
+  std::vector<NumaNodeInfo> nodes{{0, {0, 1}, 0}, {1, {2, 3}, 1}};
+  std::vector<DeviceSpec> devices{
+    makeDevice("gpu-reco", {}, {}),
+    makeDevice("pinned", {}, {})};
+  devices[0].labels.push_back({"gpu"});
+  devices[1].metadata.push_back({"numa-node", "0"});
+
+  DevicePlacementHelpers::computePlacement(devices, nodes, DevicePlacementMode::Node);
+  REQUIRE(devices[0].resource.numaNode == 1);
+  REQUIRE(devices[0].resource.cpuSet == "2-3");
+  REQUIRE(devices[1].resource.numaNode == 0);
+  REQUIRE(devices[1].resource.cpuSet == "0-1");
+}
+
+TEST_CASE("TestPlacementRequestedCpus")
+{
+  std::vector<NumaNodeInfo> nodes{{0, {0, 1, 2, 3, 4, 5, 6, 7}, 0}};
+  std::vector<DeviceSpec> devices{
+    makeDevice("reco", {}, {}),
+    makeDevice("qc", {}, {}),
+    makeDevice("remote", {}, {})};
+  devices[0].metadata.push_back({"cpus", "3"});
+  devices[2].resource.hostname = "some-other-host.invalid";
+
+  DevicePlacementHelpers::computePlacement(devices, nodes, DevicePlacementMode::Core);
+  REQUIRE(devices[0].resource.cpuSet == "0-5");
+  REQUIRE(devices[1].resource.cpuSet == "6-7");
+  // We do not know the topology of other hosts.
+  REQUIRE(devices[2].resource.numaNode == -1);
+  REQUIRE(devices[2].resource.cpuSet.empty());
+}
@@ -133,6 +133,15 @@ TEST_CASE("TestInputRecord")
   REQUIRE(record.get<int>("x") == 1);
   REQUIRE(record.get<int>("x") == 1);
 
+  // Bindings can also be hashed at compile time
+  REQUIRE(record.get<int>(BINDING("x")) == 1);
+  REQUIRE(record.get<int>(BINDING("y")) == 2);
+  REQUIRE(record.isValid(BINDING("y")) == true);
+  REQUIRE(record.isValid(BINDING("z")) == false);
+  REQUIRE(record.isValid(BINDING("err")) == false);
+  REQUIRE_THROWS_AS(record.get(BINDING("err")), RuntimeErrorRef);
+  REQUIRE(record.getPos("y") == record.getPos(BINDING("y").hash, "y"));
+
   // test the iterator
   int position = 0;
   for (auto input = record.begin(), end = record.end(); input != end; input++, position++) {
@@ -0,0 +1,78 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#include <catch_amalgamated.hpp>
+#include "../src/OutputMessagePool.h"
+#include <fairmq/Message.h>
+#include <fairmq/TransportFactory.h>
+
+using namespace o2::framework;
+
+TEST_CASE("TestOutputMessagePoolSizeClass")
+{
+  REQUIRE(OutputMessagePool::sizeClass(1) == 0);
+  REQUIRE(OutputMessagePool::sizeClass(4096) == 0);
+  REQUIRE(OutputMessagePool::sizeClass(4097) == 1);
+  REQUIRE(OutputMessagePool::sizeClass(8192) == 1);
+  REQUIRE(OutputMessagePool::sizeClass(1 << 20) == 8);
+  REQUIRE(OutputMessagePool::blockSize(OutputMessagePool::sizeClass(5000)) == 8192);
+}
+
+TEST_CASE("TestOutputMessagePoolReuse")
+{
+  auto transport = fair::mq::TransportFactory::CreateTransportFactory("zeromq");
+  OutputMessagePool pool{*transport, 16 * 4096};
+
+  auto message = pool.create(5000);
+  REQUIRE(message != nullptr);
+  REQUIRE(message->GetSize() == 5000);
+  void* data = message->GetData();
+  REQUIRE(pool.create(0) == nullptr);
+  // Once released, the block is handed out again.
+  message.reset();
+  auto again = pool.create(6000);
+  REQUIRE(again != nullptr);
+  REQUIRE(again->GetData() == data);
+  REQUIRE(pool.reused() == 1);
+
+  // Requests which do not fit fall back to the caller.
+  REQUIRE(pool.create(32 * 4096) == nullptr);
+}
+
+TEST_CASE("TestOutputMessagePoolCoalescing")
+{
+  auto transport = fair::mq::TransportFactory::CreateTransportFactory("zeromq");
+  OutputMessagePool pool{*transport, 4 * 4096};
+
+  auto a = pool.create(4096);
+  auto b = pool.create(4096);
+  auto c = pool.create(2 * 4096);
+  REQUIRE(a != nullptr);
+  REQUIRE(b != nullptr);
+  REQUIRE(c != nullptr);
+  REQUIRE(pool.create(4096) == nullptr);
+  void* first = a->GetData();
+
+  // Two released buddies can serve a larger message.
+  a.reset();
+  b.reset();
+  auto merged = pool.create(2 * 4096);
+  REQUIRE(merged != nullptr);
+  REQUIRE(merged->GetData() == first);
+
+  // A larger free block is split for smaller messages.
+  merged.reset();
+  auto small = pool.create(100);
+  REQUIRE(small != nullptr);
+  REQUIRE(small->GetData() == first);
+  REQUIRE(pool.create(100) != nullptr);
+  REQUIRE(pool.create(100) == nullptr);
+}
@@ -0,0 +1,93 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#include <catch_amalgamated.hpp>
+#include "Framework/RateLimiter.h"
+#include <chrono>
+#include <cmath>
+
+using namespace o2::framework;
+using namespace std::chrono_literals;
+
+namespace
+{
+bool near(float a, float b)
+{
+  return std::abs(a - b) < 1e-4f;
+}
+
+/// Publish and consume @a n timeframes, starting from @a tf at @a when, each
+/// one taking @a latency to go through the workflow.
+void process(AdaptiveRateLimit& rate, int64_t& tf, AdaptiveRateLimit::TimePoint& when, int n, std::chrono::milliseconds latency)
+{
+  for (int i = 0; i < n; ++i) {
+    rate.update(4, tf, -1.f);
+    rate.sent(tf, when);
+    rate.consumed(tf + 1, when + latency);
+    ++tf;
+    when += 1s;
+  }
+}
+} // namespace
+
+TEST_CASE("TestAdaptiveRateLimitSHM")
+{
+  AdaptiveRateLimit rate;
+  rate.update(10, 0, 0.f);
+  REQUIRE(rate.limit() == 10.f);
+
+  // Back off under SHM pressure, at most once per round of timeframes in flight.
+  rate.update(10, 10, 0.9f);
+  REQUIRE(near(rate.limit(), 7.f));
+  rate.update(10, 11, 0.9f);
+  REQUIRE(near(rate.limit(), 7.f));
+  rate.update(10, 17, 0.9f);
+  REQUIRE(near(rate.limit(), 4.9f));
+
+  // Nothing changes between the two thresholds.
+  rate.update(10, 18, 0.7f);
+  REQUIRE(near(rate.limit(), 4.9f));
+
+  // Grow additively once the pressure is gone, up to the maximum.
+  rate.update(10, 19, 0.1f);
+  REQUIRE(near(rate.limit(), 4.9f + 1.f / 4.9f));
+  for (int64_t sent = 20; sent < 120; ++sent) {
+    rate.update(10, sent, 0.1f);
+  }
+  REQUIRE(rate.limit() == 10.f);
+
+  // Never below one timeframe in flight.
+  for (int64_t sent = 200; sent < 400; sent += 10) {
+    rate.update(10, sent, 0.95f);
+  }
+  REQUIRE(rate.limit() == 1.f);
+}
+
+TEST_CASE("TestAdaptiveRateLimitLatency")
+{
+  AdaptiveRateLimit rate;
+  int64_t tf = 0;
+  AdaptiveRateLimit::TimePoint when{};
+  process(rate, tf, when, 10, 100ms);
+  REQUIRE(near(rate.minLatency(), 0.1f));
+  REQUIRE(rate.limit() == 4.f);
+
+  // The workflow becomes much slower: back off.
+  process(rate, tf, when, 10, 500ms);
+  REQUIRE(rate.limit() < 4.f);
+
+  // Once the best latency was measured again over a whole window, the
+  // slower workflow is the new normal and the limit grows back.
+  process(rate, tf, when, 2 * AdaptiveRateLimit::MinLatencyWindow.count(), 500ms);
+  REQUIRE(near(rate.minLatency(), 0.5f));
+  process(rate, tf, when, 20, 500ms);
+  REQUIRE(rate.limit() == 4.f);
+}
@@ -0,0 +1,103 @@
+// Copyright 2019-2020 CERN and copyright holders of ALICE O2.
+// See https://alice-o2.web.cern.ch/copyright for details of the copyright holders.
+// All rights not expressly granted are reserved.
+//
+// This software is distributed under the terms of the GNU General Public
+// License v3 (GPL Version 3), copied verbatim in the file "COPYING".
+//
+// In applying this license CERN does not waive the privileges and immunities
+// granted to it by virtue of its status as an Intergovernmental Organization
+// or submit itself to any jurisdiction.
+
+#include <catch_amalgamated.hpp>
+
+#include "../src/TopologyCacheHelpers.h"
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace o2::framework;
+
+namespace
+{
+std::vector<DeviceSpec> makeSpecs()
+{
+  std::vector<DeviceSpec> specs(2);
+  specs[0].id = "A";
+  specs[0].options.push_back(ConfigParamSpec{"foo", VariantType::Int, 1, {"foo"}});
+  specs[1].id = "B";
+  return specs;
+}
+
+DeviceExecution makeExecution(std::string const& id, std::string const& workflowId)
+{
+  DeviceExecution execution;
+  for (auto arg : {std::string("o2-dpl-test"), std::string("--id"), id, std::string("--session"), "dpl_" + workflowId, std::string("--rate"), "1" + workflowId + "0"}) {
+    execution.args.push_back(strdup(arg.c_str()));
+  }
+  execution.args.push_back(nullptr);
+  execution.environ.push_back(strdup(("WORKFLOW_ID=" + workflowId).c_str()));
+  return execution;
+}
+} // namespace
+
+TEST_CASE("TestTopologyCacheKey")
+{
+  auto specs = makeSpecs();
+  std::vector<DataProcessorInfo> infos{{"A", "o2-dpl-test", {"--session", "dpl_1234"}, {}, {}}};
+
+  auto key = TopologyCacheHelpers::cacheKey(specs, infos, "context", "1234");
+  // A different invocation of the same workflow has the same key.
+  std::vector<DataProcessorInfo> otherInfos{{"A", "o2-dpl-test", {"--session", "dpl_5678"}, {}, {}}};
+  REQUIRE(TopologyCacheHelpers::cacheKey(specs, otherInfos, "context", "5678") == key);
+  // Any change in the options invalidates it.
+  REQUIRE(TopologyCacheHelpers::cacheKey(specs, infos, "other context", "1234") != key);
+  specs[0].options[0].defaultValue = 2;
+  REQUIRE(TopologyCacheHelpers::cacheKey(specs, infos, "context", "1234") != key);
+  // So does a change in the environment the command line depends on.
+  key = TopologyCacheHelpers::cacheKey(specs, infos, "context", "1234");
+  char const* signposts = getenv("DPL_SIGNPOSTS");
+  std::string oldSignposts = signposts ? signposts : "";
+  setenv("DPL_SIGNPOSTS", (oldSignposts + ",test-topology-cache").c_str(), 1);
+  auto otherKey = TopologyCacheHelpers::cacheKey(specs, infos, "context", "1234");
+  if (signposts) {
+    setenv("DPL_SIGNPOSTS", oldSignposts.c_str(), 1);
+  } else {
+    unsetenv("DPL_SIGNPOSTS");
+  }
+  REQUIRE(otherKey != key);
+}
+
+TEST_CASE("TestTopologyCacheRoundTrip")
+{
+  auto specs = makeSpecs();
+  std::vector<DeviceExecution> executions{makeExecution("A", "1234"), makeExecution("B", "1234")};
+  std::vector<DeviceControl> controls(2);
+  controls[0].options["session"] = "dpl_1234";
+
+  std::stringstream cache;
+  TopologyCacheHelpers::save(cache, "1234", specs, executions, controls);
+
+  std::vector<DeviceExecution> loadedExecutions;
+  std::vector<DeviceControl> loadedControls;
+  REQUIRE(TopologyCacheHelpers::load(cache, "5678", specs, loadedExecutions, loadedControls));
+  REQUIRE(loadedExecutions.size() == 2);
+  auto expected = makeExecution("A", "5678");
+  REQUIRE(loadedExecutions[0].args.size() == expected.args.size());
+  REQUIRE(loadedExecutions[0].args.back() == nullptr);
+  for (size_t ai = 0; ai < 6; ++ai) {
+    REQUIRE(std::string(loadedExecutions[0].args[ai]) == expected.args[ai]);
+  }
+  // Larger numbers which happen to contain the id are left untouched.
+  REQUIRE(std::string(loadedExecutions[0].args[6]) == "112340");
+  REQUIRE(std::string(loadedExecutions[1].environ[0]) == "WORKFLOW_ID=5678");
+  REQUIRE(loadedControls[0].options["session"] == "dpl_5678");
+
+  // A cache for a different topology is not used.
+  cache.clear();
+  cache.seekg(0);
+  specs[1].id = "C";
+  REQUIRE(TopologyCacheHelpers::load(cache, "5678", specs, loadedExecutions, loadedControls) == false);
+}
@@ -150,6 +150,7 @@ o2_log_handle_t* o2_walk_logs(bool (*callback)(char const* name, void* log, void
 #include <cassert>
 #include <cinttypes>
 #include <cstddef>
+#include <cstdio>
 
 struct _o2_lock_free_stack {
   static constexpr size_t N = 1024;
@@ -197,6 +198,34 @@ struct _o2_log_t {
 
   // Default stacktrace level for the log, when enabled.
   int defaultStacktrace = 1;
+
+  // Wether the signposts of this log are recorded in the trace buffers.
+  // 0 means they are not, anything else means they are.
+  int trace = 0;
+};
+
+// A signpost as recorded for the trace export. We keep only
+// the name (which is always a string literal) and not the message,
+// so that recording does not need any formatting.
+struct _o2_trace_event_t {
+  uint64_t ticks = 0;
+  _o2_log_t* log = nullptr;
+  char const* name = nullptr;
+  int64_t id = -1;
+  // 'b' for interval begin, 'e' for interval end, 'n' for events.
+  char phase = 0;
+};
+
+// Each thread records its signposts in its own circular buffer, so
+// that no locking is needed. The only synchronization is on head,
+// which is written by the owning thread and read when dumping.
+// Older events are overwritten when the buffer is full.
+struct _o2_trace_buffer_t {
+  static constexpr size_t N = 1 << 15;
+  std::atomic<uint64_t> head = 0;
+  int tid = 0;
+  _o2_trace_buffer_t* next = nullptr;
+  _o2_trace_event_t events[N];
 };
 
 bool _o2_lock_free_stack_push(_o2_lock_free_stack& stack, const int& value, bool spin = false);
@@ -206,6 +235,15 @@ void _o2_signpost_event_emit(_o2_log_t* log, _o2_signpost_id_t id, char const* n
 void _o2_signpost_interval_begin(_o2_log_t* log, _o2_signpost_id_t id, char const* name, char const* const format, ...);
 void _o2_signpost_interval_end(_o2_log_t* log, _o2_signpost_id_t id, char const* name, char const* const format, ...);
 void _o2_log_set_stacktrace(_o2_log_t* log, int stacktrace);
+void _o2_log_set_trace(_o2_log_t* log, int trace);
+void _o2_signpost_trace_record(_o2_log_t* log, _o2_signpost_id_t id, char const* name, char phase);
+// Dump all the recorded signposts to @a out in the Chrome trace (JSON array) format,
+// which is also understood by Perfetto. Timestamps are in microseconds of the
+// monotonic clock, so that traces of different processes on the same node can be merged.
+// @return the number of events written.
+size_t _o2_signpost_trace_dump(FILE* out, int pid, char const* processName);
+// @return true if no thread recorded any signpost for the trace.
+bool _o2_signpost_trace_empty();
 
 // This generates a unique id for a signpost. Do not use this directly, use O2_SIGNPOST_ID_GENERATE instead.
 // Notice that this is only valid on a given computer.
@@ -235,6 +273,10 @@ inline _o2_signpost_id_t _o2_signpost_id_make_with_pointer(_o2_log_t* log, void
 #include <cstdio>
 #include <cstring>
 #include <execinfo.h>
+#include <chrono>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
 #include "Framework/RuntimeError.h"
 #include "Framework/BacktraceHelpers.h"
 void _o2_signpost_interval_end_v(_o2_log_t* log, _o2_signpost_id_t id, char const* name, char const* const format, va_list args);
@@ -458,12 +500,126 @@ void _o2_log_set_stacktrace(_o2_log_t* log, int stacktrace)
 {
   log->stacktrace = stacktrace;
 }
+
+void _o2_log_set_trace(_o2_log_t* log, int trace)
+{
+  log->trace = trace;
+}
+
+// We use the TSC where available, since it is much cheaper than
+// going through clock_gettime. The conversion to time happens only when dumping.
+static uint64_t _o2_signpost_trace_ticks()
+{
+#if defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#else
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+static int64_t _o2_signpost_trace_ns()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// The point at which ticks and the monotonic clock were first sampled together.
+// Together with a second sample at dump time, this allows converting ticks to time.
+struct _o2_trace_epoch_t {
+  uint64_t ticks = _o2_signpost_trace_ticks();
+  int64_t ns = _o2_signpost_trace_ns();
+};
+
+static _o2_trace_epoch_t& _o2_trace_epoch()
+{
+  static _o2_trace_epoch_t epoch;
+  return epoch;
+}
+
+static std::atomic<_o2_trace_buffer_t*>& _o2_trace_buffers()
+{
+  static std::atomic<_o2_trace_buffer_t*> first = nullptr;
+  return first;
+}
+
+void _o2_signpost_trace_record(_o2_log_t* log, _o2_signpost_id_t id, char const* name, char phase)
+{
+  // The buffer is never deleted, so that we can still dump
+  // the signposts of threads which are already gone.
+  static thread_local _o2_trace_buffer_t* buffer = nullptr;
+  if (O2_BUILTIN_UNLIKELY(buffer == nullptr)) {
+    static std::atomic<int> nextTid = 0;
+    _o2_trace_epoch();
+    buffer = new _o2_trace_buffer_t();
+    buffer->tid = nextTid++;
+    buffer->next = _o2_trace_buffers().load();
+    while (!_o2_trace_buffers().compare_exchange_weak(buffer->next, buffer,
+                                                      std::memory_order_release,
+                                                      std::memory_order_relaxed)) {
+    }
+  }
+  uint64_t head = buffer->head.load(std::memory_order_relaxed);
+  _o2_trace_event_t& event = buffer->events[head % _o2_trace_buffer_t::N];
+  event.ticks = _o2_signpost_trace_ticks();
+  event.log = log;
+  event.name = name;
+  event.id = id.value;
+  event.phase = phase;
+  buffer->head.store(head + 1, std::memory_order_release);
+}
+
+bool _o2_signpost_trace_empty()
+{
+  return _o2_trace_buffers().load(std::memory_order_acquire) == nullptr;
+}
+
+size_t _o2_signpost_trace_dump(FILE* out, int pid, char const* processName)
+{
+  auto& epoch = _o2_trace_epoch();
+  uint64_t nowTicks = _o2_signpost_trace_ticks();
+  int64_t nowNs = _o2_signpost_trace_ns();
+  double nsPerTick = nowTicks > epoch.ticks ? double(nowNs - epoch.ns) / double(nowTicks - epoch.ticks) : 1.;
+
+  struct LogName {
+    _o2_log_t* log;
+    char const* name;
+  };
+
+  fprintf(out, "[{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%d,\"args\":{\"name\":\"%s\"}}", pid, processName);
+  size_t count = 0;
+  for (auto* buffer = _o2_trace_buffers().load(std::memory_order_acquire); buffer; buffer = buffer->next) {
+    uint64_t head = buffer->head.load(std::memory_order_acquire);
+    uint64_t first = head > _o2_trace_buffer_t::N ? head - _o2_trace_buffer_t::N : 0;
+    for (uint64_t i = first; i < head; ++i) {
+      auto const& event = buffer->events[i % _o2_trace_buffer_t::N];
+      LogName logName{event.log, "unknown"};
+      o2_walk_logs([](char const* name, void* log, void* context) -> bool {
+        auto* logName = (LogName*)context;
+        if (log == logName->log) {
+          logName->name = name;
+          return false;
+        }
+        return true;
+      },
+                   &logName);
+      double ts = (epoch.ns + ((int64_t)event.ticks - (int64_t)epoch.ticks) * nsPerTick) / 1000.;
+      fprintf(out, ",\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"%c\",\"id\":\"0x%" PRIx64 "\",\"ts\":%.3f,\"pid\":%d,\"tid\":%d}",
+              event.name, logName.name, event.phase, (uint64_t)event.id, ts, pid, buffer->tid);
+      ++count;
+    }
+  }
+  fprintf(out, "]\n");
+  return count;
+}
 // A C function which can be used to enable the signposts
 extern "C" {
 void o2_debug_log_set_stacktrace(_o2_log_t* log, int stacktrace)
 {
   log->stacktrace = stacktrace;
 }
+void o2_debug_log_set_trace(_o2_log_t* log, int trace)
+{
+  log->trace = trace;
+}
 }
 #endif // O2_SIGNPOST_IMPLEMENTATION
 
@@ -477,6 +633,13 @@ void o2_debug_log_set_stacktrace(_o2_log_t* log, int stacktrace)
 // When we enable the log, we set the stacktrace to the default value.
 #define O2_LOG_ENABLE(log) _o2_log_set_stacktrace(private_o2_log_##log, private_o2_log_##log->defaultStacktrace)
 #define O2_LOG_DISABLE(log) _o2_log_set_stacktrace(private_o2_log_##log, 0)
+// Record the signposts of the log in the trace buffers, see _o2_signpost_trace_dump.
+#define O2_LOG_TRACE_ENABLE(log) _o2_log_set_trace(private_o2_log_##log, 1)
+#define O2_LOG_TRACE_DISABLE(log) _o2_log_set_trace(private_o2_log_##log, 0)
+#define O2_SIGNPOST_TRACE(log, id, name, phase)                       \
+  if (O2_BUILTIN_UNLIKELY(private_o2_log_##log->trace)) {             \
+    _o2_signpost_trace_record(private_o2_log_##log, id, name, phase); \
+  }
 // For the moment we simply use LOG DEBUG. We should have proper activities so that we can
 // turn on and off the printing.
 #define O2_LOG_DEBUG(log, ...) __extension__({                        \
@@ -493,6 +656,7 @@ void o2_debug_log_set_stacktrace(_o2_log_t* log, int stacktrace)
 // they are compatible between the two implementations, we also use remove_engineering_type to remove
 // the engineering types from the format string, so that we can use the same format string for both.
 #define O2_SIGNPOST_EVENT_EMIT(log, id, name, format, ...) __extension__({                                          \
+  O2_SIGNPOST_TRACE(log, id, name, 'n');                                                                            \
   if (O2_BUILTIN_UNLIKELY(O2_SIGNPOST_ENABLED_MAC(log))) {                                                          \
     O2_SIGNPOST_EVENT_EMIT_MAC(log, id, name, format, ##__VA_ARGS__);                                               \
   } else if (O2_BUILTIN_UNLIKELY(private_o2_log_##log->stacktrace)) {                                               \
@@ -502,6 +666,7 @@ void o2_debug_log_set_stacktrace(_o2_log_t* log, int stacktrace)
 
 // Similar to the above, however it will print a normal info message if the signpost is not enabled.
 #define O2_SIGNPOST_EVENT_EMIT_INFO(log, id, name, format, ...) __extension__({                                     \
+  O2_SIGNPOST_TRACE(log, id, name, 'n');                                                                            \
   if (O2_BUILTIN_UNLIKELY(O2_SIGNPOST_ENABLED_MAC(log))) {                                                          \
     O2_SIGNPOST_EVENT_EMIT_MAC(log, id, name, format, ##__VA_ARGS__);                                               \
   } else if (O2_BUILTIN_UNLIKELY(private_o2_log_##log->stacktrace)) {                                               \
@@ -513,6 +678,7 @@ void o2_debug_log_set_stacktrace(_o2_log_t* log, int stacktrace)
 
 // Similar to the above, however it will always print a normal error message regardless of the signpost being enabled or not.
 #define O2_SIGNPOST_EVENT_EMIT_ERROR(log, id, name, format, ...) __extension__({                                    \
+  O2_SIGNPOST_TRACE(log, id, name, 'n');                                                                            \
   if (O2_BUILTIN_UNLIKELY(O2_SIGNPOST_ENABLED_MAC(log))) {                                                          \
     O2_SIGNPOST_EVENT_EMIT_MAC(log, id, name, format, ##__VA_ARGS__);                                               \
   } else if (O2_BUILTIN_UNLIKELY(private_o2_log_##log->stacktrace)) {                                               \
@@ -523,6 +689,7 @@ void o2_debug_log_set_stacktrace(_o2_log_t* log, int stacktrace)
 
 // Similar to the above, however it will also print a normal warning message regardless of the signpost being enabled or not.
 #define O2_SIGNPOST_EVENT_EMIT_WARN(log, id, name, format, ...) __extension__({                                     \
+  O2_SIGNPOST_TRACE(log, id, name, 'n');                                                                            \
   if (O2_BUILTIN_UNLIKELY(O2_SIGNPOST_ENABLED_MAC(log))) {                                                          \
     O2_SIGNPOST_EVENT_EMIT_MAC(log, id, name, format, ##__VA_ARGS__);                                               \
   } else if (O2_BUILTIN_UNLIKELY(private_o2_log_##log->stacktrace)) {                                               \
@@ -531,24 +698,30 @@ void o2_debug_log_set_stacktrace(_o2_log_t* log, int stacktrace)
   O2_LOG_MACRO_RAW(warn, remove_engineering_type(format).data(), ##__VA_ARGS__);                                    \
 })
 
-#define O2_SIGNPOST_START(log, id, name, format, ...)                                                                   \
+#define O2_SIGNPOST_START(log, id, name, format, ...) __extension__({                                               \
+  O2_SIGNPOST_TRACE(log, id, name, 'b');                                                                                \
   if (O2_BUILTIN_UNLIKELY(O2_SIGNPOST_ENABLED_MAC(log))) {                                                              \
     O2_SIGNPOST_START_MAC(log, id, name, format, ##__VA_ARGS__);                                                        \
   } else if (O2_BUILTIN_UNLIKELY(private_o2_log_##log->stacktrace)) {                                                   \
     _o2_signpost_interval_begin(private_o2_log_##log, id, name, remove_engineering_type(format).data(), ##__VA_ARGS__); \
-  }
-#define O2_SIGNPOST_END(log, id, name, format, ...)                                                                   \
+  }                                                                                                                     \
+})
+#define O2_SIGNPOST_END(log, id, name, format, ...) __extension__({                                                 \
+  O2_SIGNPOST_TRACE(log, id, name, 'e');                                                                              \
   if (O2_BUILTIN_UNLIKELY(O2_SIGNPOST_ENABLED_MAC(log))) {                                                            \
     O2_SIGNPOST_END_MAC(log, id, name, format, ##__VA_ARGS__);                                                        \
   } else if (O2_BUILTIN_UNLIKELY(private_o2_log_##log->stacktrace)) {                                                 \
     _o2_signpost_interval_end(private_o2_log_##log, id, name, remove_engineering_type(format).data(), ##__VA_ARGS__); \
-  }
+  }                                                                                                                   \
+})
 #else // This is the release implementation, it does nothing.
 #define O2_DECLARE_DYNAMIC_LOG(x)
 #define O2_DECLARE_DYNAMIC_STACKTRACE_LOG(x)
 #define O2_DECLARE_LOG(x, category)
 #define O2_LOG_ENABLE(log)
 #define O2_LOG_DISABLE(log)
+#define O2_LOG_TRACE_ENABLE(log)
+#define O2_LOG_TRACE_DISABLE(log)
 #define O2_LOG_DEBUG(log, ...)
 #define O2_SIGNPOST_ID_FROM_POINTER(name, log, pointer)
 #define O2_SIGNPOST_ID_GENERATE(name, log)
@@ -49,4 +49,15 @@ int main(int argc, char** argv)
   O2_SIGNPOST_START(test_SignpostDynamic, id, "Test category", "This is dynamic signpost which you will see, because we turned them on");
   O2_SIGNPOST_END(test_SignpostDynamic, id, "Test category", "This is dynamic signpost which you will see, because we turned them on");
 #endif
+
+  // Record the signposts in the trace buffers and dump them in the Chrome trace format.
+  O2_LOG_TRACE_ENABLE(test_Signpost);
+  O2_SIGNPOST_START(test_Signpost, id, "Test category", "This interval ends up in the trace");
+  O2_SIGNPOST_EVENT_EMIT(test_Signpost, id, "Test category", "This event ends up in the trace");
+  O2_SIGNPOST_END(test_Signpost, id, "Test category", "This interval ends up in the trace");
+  O2_LOG_TRACE_DISABLE(test_Signpost);
+  O2_SIGNPOST_EVENT_EMIT(test_Signpost, id, "Test category", "This event is not in the trace");
+  if (_o2_signpost_trace_dump(stdout, 0, "test_Signpost") != 3) {
+    return 1;
+  }
 }
@@ -45,6 +45,7 @@
 #else
 static inline int omp_get_thread_num() { return 0; }
 static inline int omp_get_max_threads() { return 1; }
+static inline int omp_in_parallel() { return 0; }
 #endif
 
 using namespace GPUCA_NAMESPACE::gpu;
@@ -73,6 +74,15 @@ inline int GPUReconstructionCPUBackend::runKernelBackendInternal(const krnlSetup
   }
   unsigned int num = y.num == 0 || y.num == -1 ? 1 : y.num;
   for (unsigned int k = 0; k < num; k++) {
+    if (mProcessingSettings.ompKernels == 3 && mNestedLoopOmpFactor > 1 && omp_in_parallel()) {
+      // Inside the outer loop over sectors: spawn the blocks as tasks, so that threads which finished their sector (or wait at a barrier) pick them up
+      GPUCA_OPENMP(taskloop grainsize(1))
+      for (unsigned int iB = 0; iB < x.nBlocks; iB++) {
+        typename T::GPUSharedMemory smem;
+        T::template Thread<I>(x.nBlocks, 1, iB, 0, smem, T::Processor(*mHostConstantMem)[y.start + k], args...);
+      }
+      continue;
+    }
     int ompThreads = 0;
     if (mProcessingSettings.ompKernels == 2) {
       ompThreads = mProcessingSettings.ompThreads / mNestedLoopOmpFactor;
@@ -381,6 +391,7 @@ unsigned int GPUReconstructionCPU::getNextTimerId()
 unsigned int GPUReconstructionCPU::SetAndGetNestedLoopOmpFactor(bool condition, unsigned int max)
 {
   if (condition && mProcessingSettings.ompKernels != 1) {
+    // ompKernels == 3 also uses all threads in the outer loop, the kernels then distribute their blocks as tasks among them
     mNestedLoopOmpFactor = mProcessingSettings.ompKernels == 2 ? std::min<unsigned int>(max, mProcessingSettings.ompThreads) : mProcessingSettings.ompThreads;
   } else {
     mNestedLoopOmpFactor = 1;
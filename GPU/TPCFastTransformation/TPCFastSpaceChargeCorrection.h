@@ -237,6 +237,10 @@ class TPCFastSpaceChargeCorrection : public FlatObject
   /// Print method
   void print() const;
   GPUh() double testInverse(bool prn = 0);
+
+  /// Bulk version of getCorrection() for n points (row[i], u[i], v[i]) of one slice.
+  /// Row and spline cell lookups are shared between neighbouring points, the spline evaluation is vectorised over blocks of points.
+  void getCorrectionBulk(int slice, int n, const int* row, const float* u, const float* v, float* dx, float* du, float* dv) const;
 #endif
 
  private:
@@ -165,6 +165,47 @@ void TPCFastTransform::print() const
 #endif
 }
 
+#if !defined(GPUCA_GPUCODE)
+
+void TPCFastTransform::TransformBulk(int slice, int n, const int* row, const float* pad, const float* time, float* x, float* y, float* z, float vertexTime) const
+{
+  /// Gives the same result as Transform() called for every cluster.
+  /// The spline correction is evaluated for all clusters at once, using the u, v arrays stored in y, z as scratch space.
+
+  if (!mApplyCorrection || mCorrectionSlow) {
+    for (int i = 0; i < n; i++) {
+      Transform(slice, row[i], pad[i], time[i], x[i], y[i], z[i], vertexTime);
+    }
+    return;
+  }
+
+  float* u = y;
+  float* v = z;
+  for (int i = 0; i < n; i++) {
+    x[i] = getGeometry().getRowInfo(row[i]).x;
+    convPadTimeToUV(slice, row[i], pad[i], time[i], u[i], v[i], vertexTime);
+  }
+
+  constexpr int kBlock = 256;
+  float dx[kBlock], du[kBlock], dv[kBlock];
+  for (int i0 = 0; i0 < n; i0 += kBlock) {
+    const int nb = (n - i0 < kBlock) ? n - i0 : kBlock;
+    mCorrection.getCorrectionBulk(slice, nb, row + i0, u + i0, v + i0, dx, du, dv);
+    for (int j = 0; j < nb; j++) {
+      const int i = i0 + j;
+      x[i] += dx[j];
+      float cu = u[i] + du[j];
+      float cv = v[i] + dv[j];
+      getGeometry().convUVtoLocal(slice, cu, cv, y[i], z[i]);
+      float dzTOF = 0;
+      getTOFcorrection(slice, row[i], x[i], y[i], z[i], dzTOF);
+      z[i] += dzTOF;
+    }
+  }
+}
+
+#endif // GPUCA_GPUCODE
+
 #if !defined(GPUCA_GPUCODE) && !defined(GPUCA_STANDALONE) && !defined(GPUCA_ALIROOT_LIB)
 
 int TPCFastTransform::writeToFile(std::string outFName, std::string name)
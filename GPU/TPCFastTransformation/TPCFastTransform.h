@@ -185,6 +185,11 @@ class TPCFastTransform : public FlatObject
   GPUd() void Transform(int slice, int row, float pad, float time, float& x, float& y, float& z, float vertexTime = 0, const TPCFastTransform* ref = nullptr, const TPCFastTransform* ref2 = nullptr, float scale = 0.f, float scale2 = 0.f, int scaleMode = 0) const;
   GPUd() void TransformXYZ(int slice, int row, float& x, float& y, float& z, const TPCFastTransform* ref = nullptr, const TPCFastTransform* ref2 = nullptr, float scale = 0.f, float scale2 = 0.f, int scaleMode = 0) const;
 
+#if !defined(GPUCA_GPUCODE)
+  /// Bulk version of Transform() for n clusters (row[i], pad[i], time[i]) of one slice, without reference maps
+  void TransformBulk(int slice, int n, const int* row, const float* pad, const float* time, float* x, float* y, float* z, float vertexTime = 0) const;
+#endif
+
   /// Transformation in the time frame
   GPUd() void TransformInTimeFrame(int slice, int row, float pad, float time, float& x, float& y, float& z, float maxTimeBin) const;
   GPUd() void TransformInTimeFrame(int slice, float time, float& z, float maxTimeBin) const;
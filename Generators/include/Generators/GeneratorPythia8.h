@@ -169,6 +169,10 @@ class GeneratorPythia8 : public Generator
   /// For values of seed >= 0, a truncation to the range [0:90000000] will automatically take place via a modulus operation.
   bool setInitialSeed(long seed);
 
+  /// Reseeds the Pythia random number state before the next event.
+  /// The seed is mapped to the range [1:MAX_SEED], since 0 would select the Pythia default seed.
+  void setEventSeed(ULong_t seed) override;
+
  protected:
   /** copy constructor **/
   GeneratorPythia8(const GeneratorPythia8&);
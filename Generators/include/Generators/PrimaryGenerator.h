@@ -82,6 +82,9 @@ class PrimaryGenerator : public FairPrimaryGenerator
 
   void setExternalVertexForNextEvent(double x, double y, double z);
 
+  /** reseeds gRandom and the random engines of all registered generators before the next event **/
+  void setEventSeed(ULong_t seed);
+
   // sets the vertex mode; if mode is kCCDB, a valid MeanVertexObject pointer must be given at the same time
   void setVertexMode(o2::conf::VertexMode const& mode, o2::dataformats::MeanVertexObject const* obj = nullptr);
   // if we apply vertex smearing
@@ -87,6 +87,12 @@ bool GeneratorPythia8::setInitialSeed(long seed)
   return true;
 }
 
+/*****************************************************************/
+void GeneratorPythia8::setEventSeed(ULong_t seed)
+{
+  mPythia.rndm.init(1 + seed % MAX_SEED);
+}
+
 /*****************************************************************/
 void GeneratorPythia8::seedGenerator()
 {
@@ -24,6 +24,7 @@
 #include "FairGenericStack.h"
 #include "TFile.h"
 #include "TTree.h"
+#include "TObjArray.h"
 
 #include "TDatabasePDG.h"
 #include "TVirtualMC.h"
@@ -259,6 +260,20 @@ void PrimaryGenerator::setExternalVertexForNextEvent(double x, double y, double
 
 /*****************************************************************/
 
+void PrimaryGenerator::setEventSeed(ULong_t seed)
+{
+  /** reseed the event generation **/
+
+  gRandom->SetSeed(seed);
+  for (int igen = 0; igen < fGenList->GetEntriesFast(); ++igen) {
+    if (auto generator = dynamic_cast<o2::eventgen::Generator*>(fGenList->At(igen))) {
+      generator->setEventSeed(seed);
+    }
+  }
+}
+
+/*****************************************************************/
+
 void PrimaryGenerator::setVertexMode(o2::conf::VertexMode const& mode, o2::dataformats::MeanVertexObject const* v)
 {
   mVertexMode = mode;
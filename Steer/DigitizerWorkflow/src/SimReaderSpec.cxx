@@ -140,7 +140,7 @@ DataProcessorSpec getSimReaderSpec(SubspecRange range, const std::vector<std::st
     auto incontextstring = ctx.options().get<std::string>("incontext");
     LOG(info) << "INCONTEXTSTRING " << incontextstring;
     if (incontextstring.size() > 0) {
-      auto success = mgr.setupRunFromExistingContext(incontextstring.c_str());
+      auto success = mgr.setupRunFromExistingContext(incontextstring.c_str(), ctx.options().get<int>("incontext-tf"));
       if (!success) {
         LOG(fatal) << "Could not read collision context from " << incontextstring;
       }
@@ -260,6 +260,7 @@ DataProcessorSpec getSimReaderSpec(SubspecRange range, const std::vector<std::st
       {"qed-x-section-ratio", VariantType::Float, -1.f, {"Ratio of cross sections QED/hadronic events. Determines QED interaction rate from hadronic interaction rate."}},
       {"outcontext", VariantType::String, "collisioncontext.root", {"Output file for collision context"}},
       {"incontext", VariantType::String, "", {"Take collision context from this file"}},
+      {"incontext-tf", VariantType::Int, -1, {"Only take the collisions of this timeframe from the input collision context (-1: all)"}},
       {"triggerfile", VariantType::String, "ctpdigits.root", {"Name of the CTP trigger/digit file to use"}},
       {"seed", VariantType::Int, 0, {"Random seed for collision context generation"}},
       {"ncollisions,n",
@@ -70,7 +70,7 @@ class HitProcessingManager
   // serializes the runcontext to file
   void writeDigitizationContext(const char* filename) const;
   // setup run from serialized context; returns true if ok
-  bool setupRunFromExistingContext(const char* filename);
+  bool setupRunFromExistingContext(const char* filename, int timeframeid = -1);
 
   void setRandomEventSequence(bool b) { mSampleCollisionsRandomly = b; }
 
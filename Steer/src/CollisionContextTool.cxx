@@ -22,6 +22,8 @@
 #include <cmath>
 #include <TRandom.h>
 #include <numeric>
+#include <algorithm>
+#include <iterator>
 #include <fairlogger/Logger.h>
 #include "Steer/MCKinematicsReader.h"
 #include "CommonUtils/ConfigurableParam.h"
@@ -53,6 +55,7 @@ struct Options {
   bool genVertices = false;         // whether to assign vertices to collisions
   std::string configKeyValues = ""; // string to init config key values
   long timestamp = -1;              // timestamp for CCDB queries
+  bool splitTimeframes = false;     // whether to write the context as independently loadable timeframe chunks
 };
 
 enum class InteractionLockMode {
@@ -198,7 +201,8 @@ bool parseOptions(int argc, char* argv[], Options& optvalues)
     "timeframeID", bpo::value<int>(&optvalues.tfid)->default_value(0), "Timeframe id of the first timeframe int this context. Allows to generate contexts for different start orbits")(
     "first-orbit", bpo::value<uint32_t>(&optvalues.firstOrbit)->default_value(0), "First orbit in the run (HBFUtils.firstOrbit)")(
     "maxCollsPerTF", bpo::value<int>(&optvalues.maxCollsPerTF)->default_value(-1), "Maximal number of MC collisions to put into one timeframe. By default no constraint.")(
-    "noEmptyTF", bpo::bool_switch(&optvalues.noEmptyTF), "Enforce to have at least one collision")("configKeyValues", bpo::value<std::string>(&optvalues.configKeyValues)->default_value(""), "Semicolon separated key=value strings (e.g.: 'TPC.gasDensity=1;...')")("with-vertices", "Assign vertices to collisions.")("timestamp", bpo::value<long>(&optvalues.timestamp)->default_value(-1L), "Timestamp for CCDB queries / anchoring");
+    "noEmptyTF", bpo::bool_switch(&optvalues.noEmptyTF), "Enforce to have at least one collision")("configKeyValues", bpo::value<std::string>(&optvalues.configKeyValues)->default_value(""), "Semicolon separated key=value strings (e.g.: 'TPC.gasDensity=1;...')")("with-vertices", "Assign vertices to collisions.")("timestamp", bpo::value<long>(&optvalues.timestamp)->default_value(-1L), "Timestamp for CCDB queries / anchoring")(
+    "split-timeframes", bpo::bool_switch(&optvalues.splitTimeframes), "Write the context as one object per timeframe, so that consumers can load single timeframes");
 
   options.add_options()("help,h", "Produce help message.");
 
@@ -290,19 +294,26 @@ int main(int argc, char* argv[])
         record = sampler.generateCollisionTime();
       } while (options.noEmptyTF && usetimeframelength && record.orbit >= orbitstart + options.orbits);
       int count = 0;
+      // the records of one sampler are ordered in time, so we collect them first and merge them
+      // into the existing collisions in one go (instead of a sorted insertion per record)
+      std::vector<std::pair<o2::InteractionTimeRecord, std::vector<o2::steer::EventPart>>> newcollisions;
       do {
         if (usetimeframelength && record.orbit >= orbitstart + options.orbits) {
           break;
         }
         std::vector<o2::steer::EventPart> parts;
         parts.emplace_back(id, count);
-
-        std::pair<o2::InteractionTimeRecord, std::vector<o2::steer::EventPart>> insertvalue(record, parts);
-        auto iter = std::lower_bound(collisions.begin(), collisions.end(), insertvalue, [](std::pair<o2::InteractionTimeRecord, std::vector<o2::steer::EventPart>> const& a, std::pair<o2::InteractionTimeRecord, std::vector<o2::steer::EventPart>> const& b) { return a.first < b.first; });
-        collisions.insert(iter, insertvalue);
+        newcollisions.emplace_back(record, parts);
         record = sampler.generateCollisionTime();
         count++;
       } while ((ispecs[id].mcnumberasked > 0 && count < ispecs[id].mcnumberasked));
+      // new records come first for equal times (as with a lower_bound insertion)
+      std::vector<std::pair<o2::InteractionTimeRecord, std::vector<o2::steer::EventPart>>> merged;
+      merged.reserve(collisions.size() + newcollisions.size());
+      std::merge(std::make_move_iterator(newcollisions.begin()), std::make_move_iterator(newcollisions.end()),
+                 std::make_move_iterator(collisions.begin()), std::make_move_iterator(collisions.end()),
+                 std::back_inserter(merged), [](auto const& a, auto const& b) { return a.first < b.first; });
+      collisions = std::move(merged);
 
       // we support randomization etc on non-injected/embedded interactions
       // and we can apply them here
@@ -431,8 +442,6 @@ int main(int argc, char* argv[])
   // apply max collision per timeframe filters + reindexing of event id (linearisation and compactification)
   digicontext.applyMaxCollisionFilter(options.tfid * options.orbitsPerTF, options.orbitsPerTF, options.maxCollsPerTF);
 
-  digicontext.finalizeTimeframeStructure(options.tfid * options.orbitsPerTF, options.orbitsPerTF);
-
   if (options.genVertices) {
     // TODO: offer option taking meanVertex directly from CCDB ! "GLO/Calib/MeanVertex"
     // sample interaction vertices
@@ -451,10 +460,17 @@ int main(int argc, char* argv[])
     digicontext.fillQED(qedSpec.name, qedSpec.mcnumberasked, qedSpec.interactionRate);
   }
 
+  // fix the timeframe structure (after QED is added, so that both record types are indexed)
+  digicontext.finalizeTimeframeStructure(options.tfid * options.orbitsPerTF, options.orbitsPerTF);
+
   if (options.printContext) {
     digicontext.printCollisionSummary(options.qedInteraction.size() > 0);
   }
-  digicontext.saveToFile(options.outfilename);
+  if (options.splitTimeframes) {
+    digicontext.saveTimeframesToFile(options.outfilename);
+  } else {
+    digicontext.saveToFile(options.outfilename);
+  }
 
   return 0;
 }
@@ -17,6 +17,7 @@
 #include <TFile.h>
 #include <TClass.h>
 #include <TRandom3.h>
+#include <memory>
 
 ClassImp(o2::steer::HitProcessingManager);
 
@@ -109,9 +110,10 @@ void HitProcessingManager::writeDigitizationContext(const char* filename) const
   mDigitizationContext.saveToFile(filename);
 }
 
-bool HitProcessingManager::setupRunFromExistingContext(const char* filename)
+bool HitProcessingManager::setupRunFromExistingContext(const char* filename, int timeframeid)
 {
-  auto context = DigitizationContext::loadFromFile(filename);
+  // a non-negative timeframeid restricts the context to the collisions of this timeframe
+  std::unique_ptr<DigitizationContext> context(timeframeid >= 0 ? DigitizationContext::loadTimeframeFromFile(filename, timeframeid) : DigitizationContext::loadFromFile(filename));
   if (context) {
     context->printCollisionSummary();
     mDigitizationContext = *context;
@@ -40,6 +40,9 @@
 #include <fstream>
 #include <iostream>
 #include <atomic>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
 #include "PrimaryServerState.h"
 #include "SimPublishChannelHelper.h"
 #include <chrono>
@@ -70,6 +73,7 @@ class O2PrimaryServerDevice final : public fair::mq::Device
       if (mGeneratorThread.joinable()) {
         mGeneratorThread.join();
       }
+      stopEventPrefetching();
       if (mControlThread.joinable()) {
         mControlThread.join();
       }
@@ -158,18 +162,25 @@ class O2PrimaryServerDevice final : public fair::mq::Device
 
     LOG(info) << "Generator initialization took " << timer.CpuTime() << "s";
     if (mMaxEvents > 0) {
-      generateEvent(); // generate a first event
+      if (mNPrefetchEvents > 0) {
+        startEventPrefetching(); // fill the event queue asynchronously
+        stateTransition(O2PrimaryServerState::ReadyToServe, "GENINIT");
+      } else {
+        generateEvent(mEventCounter); // generate a first event
+      }
     }
   }
 
-  // function generating one event
-  void generateEvent(/*bool changeState = false*/)
+  // function generating one event; eventIndex is the (0-based) index of the event
+  // in the sequence of generated events, used to look up its collision
+  void generateEvent(int eventIndex, bool changeState = true)
   {
-    bool changeState = true; // false;
     LOG(info) << "Event generation started ";
     if (changeState) {
       stateTransition(O2PrimaryServerState::WaitingEvent, "GENEVENT");
     }
+    // every event gets its own random stream derived from the initial seed
+    mPrimGen->setEventSeed(eventSeed(eventIndex));
     TStopwatch timer;
     timer.Start();
     try {
@@ -182,9 +193,9 @@ class O2PrimaryServerDevice final : public fair::mq::Device
         if (mCollissionContext) {
           const auto& vertices = mCollissionContext->getInteractionVertices();
           if (vertices.size() > 0) {
-            auto collisionindex = mEventID_to_CollID.at(mEventCounter);
+            auto collisionindex = mEventID_to_CollID.at(eventIndex);
             auto& vertex = vertices.at(collisionindex);
-            LOG(info) << "Setting vertex " << vertex << " for event " << mEventCounter << " for prefix " << mSimConfig.getOutPrefix();
+            LOG(info) << "Setting vertex " << vertex << " for event " << eventIndex << " for prefix " << mSimConfig.getOutPrefix();
             mPrimGen->setExternalVertexForNextEvent(vertex.X(), vertex.Y(), vertex.Z());
           }
         }
@@ -211,6 +222,95 @@ class O2PrimaryServerDevice final : public fair::mq::Device
     }
   }
 
+  // deterministic seed for the event with (0-based) generation index eventIndex;
+  // only depends on the initial seed, so that the generated events do not depend on whether
+  // and how deep events are prefetched
+  ULong_t eventSeed(int eventIndex) const
+  {
+    // splitmix64 finalizer to decorrelate neighbouring events
+    uint64_t z = static_cast<uint64_t>(mInitialSeed) + 0x9e3779b97f4a7c15ULL * (static_cast<uint64_t>(eventIndex) + 1);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    z = z ^ (z >> 31);
+    // limit to uint32_t range (internal limit of TRandom) and avoid 0 (which means "random seed" for TRandom3)
+    return static_cast<ULong_t>(z % std::numeric_limits<uint32_t>::max()) + 1;
+  }
+
+  // body of the prefetch thread: keeps up to mNPrefetchEvents generated events in the queue
+  void prefetchEvents()
+  {
+    while (!mStopPrefetching.load()) {
+      {
+        std::unique_lock<std::mutex> lock(mEventQueueMutex);
+        mEventQueueCV.wait(lock, [this]() { return mStopPrefetching.load() || mEventQueue.size() < mNPrefetchEvents; });
+      }
+      if (mStopPrefetching.load() || mGeneratedEventCounter >= mMaxEvents) {
+        break;
+      }
+      generateEvent(mGeneratedEventCounter, false);
+      PregeneratedEvent event;
+      event.primaries = mStack->getPrimaries();
+      event.header = mEventHeader;
+      mGeneratedEventCounter++;
+      {
+        std::lock_guard<std::mutex> lock(mEventQueueMutex);
+        mEventQueue.emplace_back(std::move(event));
+      }
+      mEventQueueCV.notify_all();
+    }
+    {
+      std::lock_guard<std::mutex> lock(mEventQueueMutex);
+      mPrefetchingDone = true;
+    }
+    mEventQueueCV.notify_all();
+    LOG(info) << "Event prefetching finished after " << mGeneratedEventCounter << " events";
+  }
+
+  void startEventPrefetching()
+  {
+    stopEventPrefetching();
+    mStopPrefetching = false;
+    mPrefetchingDone = false;
+    mPrefetchThread = std::thread(&O2PrimaryServerDevice::prefetchEvents, this);
+  }
+
+  void stopEventPrefetching()
+  {
+    mStopPrefetching = true;
+    mEventQueueCV.notify_all();
+    if (mPrefetchThread.joinable()) {
+      mPrefetchThread.join();
+    }
+    std::lock_guard<std::mutex> lock(mEventQueueMutex);
+    mEventQueue.clear();
+    mGeneratedEventCounter = 0;
+  }
+
+  // takes the next pre-generated event from the queue, blocking until one is available;
+  // returns false if the prefetching stopped and no event is left
+  bool popPrefetchedEvent()
+  {
+    auto start = std::chrono::steady_clock::now();
+    {
+      std::unique_lock<std::mutex> lock(mEventQueueMutex);
+      mEventQueueCV.wait(lock, [this]() { return !mEventQueue.empty() || mPrefetchingDone || mStopPrefetching.load(); });
+      if (mEventQueue.empty()) {
+        LOG(warn) << "No pre-generated event available after " << mGeneratedEventCounter << " events";
+        return false;
+      }
+      mCurrentEvent = std::move(mEventQueue.front());
+      mEventQueue.pop_front();
+    }
+    mEventQueueCV.notify_all();
+    std::chrono::duration<double> waited = std::chrono::steady_clock::now() - start;
+    mEventWaitTime += waited.count();
+    if (waited.count() > 0.001) {
+      mEventWaitCount++;
+      LOG(info) << "Workers idled " << waited.count() << "s waiting for event generation";
+    }
+    return true;
+  }
+
   // launches a thread that listens for status requests from outside asynchronously
   void launchInfoThread()
   {
@@ -295,6 +395,10 @@ class O2PrimaryServerDevice final : public fair::mq::Device
 
     mMaxEvents = conf.getNEvents();
 
+    // number of events to pre-generate asynchronously (0 = generate next event after previous was served)
+    mNPrefetchEvents = vm["prefetchEvents"].as<unsigned int>();
+    LOG(info) << "EVENT PREFETCH SET TO " << mNPrefetchEvents;
+
     // need to make ROOT thread-safe since we use ROOT services in all places
     ROOT::EnableThreadSafety();
 
@@ -389,6 +493,7 @@ class O2PrimaryServerDevice final : public fair::mq::Device
         LOG(warn) << "Exception during thread join ..ignoring";
       }
     }
+    stopEventPrefetching();
     // mGeneratorThread = std::thread(&O2PrimaryServerDevice::initGenerator, this);
     initGenerator();
 
@@ -468,6 +573,9 @@ class O2PrimaryServerDevice final : public fair::mq::Device
 
   void PostRun() override
   {
+    if (mNPrefetchEvents > 0) {
+      LOG(info) << "Workers idled " << mEventWaitTime << "s in total waiting for event generation (" << mEventWaitCount << " times)";
+    }
     while (!mInfoThreadStopped) {
       LOG(info) << "Waiting info thread";
       using namespace std::chrono_literals;
@@ -488,6 +596,16 @@ class O2PrimaryServerDevice final : public fair::mq::Device
       // send a zero answer
       workavailable = false;
     }
+    // with prefetching, the next event comes from the queue (if the generation did not stop)
+    if (workavailable && mNeedNewEvent && mNPrefetchEvents > 0) {
+      if (popPrefetchedEvent()) {
+        mNeedNewEvent = false;
+        mPartCounter = 0;
+        mEventCounter++;
+      } else {
+        workavailable = false;
+      }
+    }
 
     PrimaryChunkAnswer header{mState, workavailable};
     fair::mq::Parts reply;
@@ -516,7 +634,7 @@ class O2PrimaryServerDevice final : public fair::mq::Device
         mEventCounter++;
       }
 
-      auto& prims = mStack->getPrimaries();
+      const auto& prims = mNPrefetchEvents > 0 ? mCurrentEvent.primaries : mStack->getPrimaries();
       auto numberofparts = (int)std::ceil(prims.size() / (1. * mChunkGranularity));
       // number of parts should be at least 1 (even if empty)
       numberofparts = std::max(1, numberofparts);
@@ -534,7 +652,7 @@ class O2PrimaryServerDevice final : public fair::mq::Device
       const uint64_t drawnSeed = (uint64_t)(static_cast<double>(std::numeric_limits<uint32_t>::max()) * mSeedGenerator.Rndm());
       i.seed = mUseFixedChunkSeed ? mFixedChunkSeed : drawnSeed;
       i.index = m.mParticles.size();
-      i.mMCEventHeader = mEventHeader;
+      i.mMCEventHeader = mNPrefetchEvents > 0 ? mCurrentEvent.header : mEventHeader;
       m.mSubEventInfo = i;
 
       int endindex = prims.size() - mPartCounter * mChunkGranularity;
@@ -564,9 +682,9 @@ class O2PrimaryServerDevice final : public fair::mq::Device
       mPartCounter++;
       if (mPartCounter == numberofparts) {
         mNeedNewEvent = true;
-        // start generation of a new event
-        if (mEventCounter < mMaxEvents) {
-          mGeneratorThread = std::thread(&O2PrimaryServerDevice::generateEvent, this);
+        // start generation of a new event (unless done by the prefetch thread)
+        if (mEventCounter < mMaxEvents && mNPrefetchEvents == 0) {
+          mGeneratorThread = std::thread([this, eventIndex = mEventCounter]() { generateEvent(eventIndex); });
         }
       }
 
@@ -687,6 +805,23 @@ class O2PrimaryServerDevice final : public fair::mq::Device
   std::unordered_map<int, int> mEventID_to_CollID;              //!
 
   TRandom3 mSeedGenerator; //! specific random generator for seed generation for work chunks
+
+  // asynchronous event pre-generation
+  struct PregeneratedEvent {
+    std::vector<TParticle> primaries;
+    o2::dataformats::MCEventHeader header;
+  };
+  unsigned int mNPrefetchEvents = 0;         // max number of events kept pre-generated (0 = no prefetching)
+  std::deque<PregeneratedEvent> mEventQueue; //! bounded queue of pre-generated events
+  std::mutex mEventQueueMutex;               //!
+  std::condition_variable mEventQueueCV;     //!
+  std::thread mPrefetchThread;               //! thread filling the event queue
+  std::atomic<bool> mStopPrefetching{false}; //!
+  bool mPrefetchingDone = false;             //! set (under mEventQueueMutex) once the prefetch thread exits
+  int mGeneratedEventCounter = 0;            // number of events generated by the prefetch thread
+  PregeneratedEvent mCurrentEvent;           //! the event currently being served in chunks
+  double mEventWaitTime = 0.;                // accumulated time requests waited for an event
+  int mEventWaitCount = 0;                   // number of times requests had to wait for an event
 };
 
 } // namespace devices
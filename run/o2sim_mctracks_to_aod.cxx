@@ -12,12 +12,18 @@
 // #include "O2RivetExporter.h"
 #include "../Detectors/AOD/include/AODProducerWorkflow/AODMcProducerHelpers.h"
 #include <Framework/AnalysisTask.h>
+#include <Framework/DataRefUtils.h>
 #include <SimulationDataFormat/InteractionSampler.h>
 #include <Framework/runDataProcessing.h>
 
 template <typename T>
 using Configurable = o2::framework::Configurable<T>;
 
+/** Converts the MC events of each incoming timeframe into the AOD
+    MC tables. The events are consumed part by part as published by the
+    event generator or sim proxy. One DataFrame is written per timeframe,
+    so its size, and the memory used for the conversion, is set by the
+    --aggregate-timeframe option of the publisher. */
 struct MctracksToAod {
   /** @{
       @name Types used */
@@ -57,6 +63,9 @@ struct MctracksToAod {
   InteractionSampler mSampler;
   /** Whether to filter tracks */
   bool mFilter;
+  /** Track to particle-index mapping, reused between events to avoid
+      re-allocating the hash table for every event */
+  o2::aodmchelpers::TrackToIndex mPreselect;
 
   /** Initialize */
   void init(o2::framework::InitContext& /*ic*/)
@@ -85,6 +94,16 @@ struct MctracksToAod {
                 << ", shipping the empty timeframe";
       return;
     }
+    // Pre-size the output tables from the incoming payload sizes, so
+    // that the table builders do not repeatedly grow (and transiently
+    // double) their buffers while converting large timeframes.
+    size_t trackBytes = 0;
+    for (auto i = 0U; i < nParts; ++i) {
+      trackBytes += o2::framework::DataRefUtils::getPayloadSize(pc.inputs().getDataRefByString("mctracks", i));
+    }
+    mCollisions.reserve(nParts);
+    mParticles.reserve(trackBytes / sizeof(McTrack) + 1);
+
     // TODO: include BC simulation
     auto bcCounter = 0UL;
     size_t offset = 0;
@@ -109,11 +128,11 @@ struct MctracksToAod {
       updateHepMCHeavyIon(mHeavyIons.cursor, bcCounter, genID, *header);
 
       LOG(debug) << "Updating particles table";
-      TrackToIndex preselect;
+      mPreselect.clear();
       offset = updateParticles(mParticles.cursor,
                                bcCounter,
                                tracks,
-                               preselect,
+                               mPreselect,
                                offset,
                                mFilter,
                                false);